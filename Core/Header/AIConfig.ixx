@@ -1,5 +1,7 @@
 export module Core.AIConfig;
 import <string>;
+import <cstdint>;
+import <memory>;
 import <fstream>;
 import <sstream>;
 export namespace Core {
@@ -7,6 +9,10 @@ export namespace Core {
         BRITNEY,  
         SPEARS    
     };
+    enum class SearchParallelism : uint8_t {
+        ROOT,
+        TREE
+    };
     inline std::string playstyleToString(Playstyle style) {
         switch (style) {
             case Playstyle::BRITNEY: return "Britney";
@@ -74,7 +80,7 @@ export namespace Core {
             return true;
         }
     };
-    inline AIWeights getDefaultWeights(Playstyle style) {
+    constexpr AIWeights getDefaultWeights(Playstyle style) {
         AIWeights weights;
         switch (style) {
             case Playstyle::BRITNEY:
@@ -106,38 +112,58 @@ export namespace Core {
         }
         return weights;
     }
+    struct WeightsSnapshot {
+        Playstyle playstyle = Playstyle::BRITNEY;
+        AIWeights weights;
+        uint64_t version = 0;
+        bool loadedFromFile = false;
+    };
+    class WeightsRegistry {
+    public:
+        static WeightsSnapshot current(Playstyle style);
+        static WeightsSnapshot publish(Playstyle style, const AIWeights& weights);
+        static bool reloadIfChanged(Playstyle style);
+        static void reloadAllIfChanged();
+        static void setHotReload(bool enabled);
+        static bool isHotReloadEnabled();
+        static std::string weightsPath(Playstyle style);
+    };
     class AIConfig {
     private:
         Playstyle m_playstyle;
         double m_explorationConstant;
         int m_mctsIterations;
         int m_maxSimulationDepth;
+        int m_searchThreads;
+        SearchParallelism m_parallelism;
     public:
         AIConfig(Playstyle style = Playstyle::BRITNEY, 
                  double explorationConstant = 1.414,
                  int mctsIterations = 1000,
-                 int maxSimulationDepth = 20)
+                 int maxSimulationDepth = 20,
+                 int searchThreads = 1,
+                 SearchParallelism parallelism = SearchParallelism::ROOT)
             : m_playstyle(style)
             , m_explorationConstant(explorationConstant)
             , m_mctsIterations(mctsIterations)
             , m_maxSimulationDepth(maxSimulationDepth)
+            , m_searchThreads(searchThreads)
+            , m_parallelism(parallelism)
         {}
         Playstyle getPlaystyle() const { return m_playstyle; }
         double getExplorationConstant() const { return m_explorationConstant; }
         int getMCTSIterations() const { return m_mctsIterations; }
         int getMaxSimulationDepth() const { return m_maxSimulationDepth; }
+        int getSearchThreads() const { return m_searchThreads; }
+        SearchParallelism getParallelism() const { return m_parallelism; }
         void setPlaystyle(Playstyle style) { m_playstyle = style; }
         void setExplorationConstant(double val) { m_explorationConstant = val; }
         void setMCTSIterations(int val) { m_mctsIterations = val; }
         void setMaxSimulationDepth(int val) { m_maxSimulationDepth = val; }
+        void setSearchThreads(int val) { m_searchThreads = val; }
+        void setParallelism(SearchParallelism mode) { m_parallelism = mode; }
         AIWeights getWeights() const {
-            AIWeights weights;
-            std::string styleStr = playstyleToString(m_playstyle);
-            std::string optimizedPath = "OptimizedWeights/" + styleStr + "_optimized.weights";
-            if (weights.loadFromFile(optimizedPath)) {
-                return weights;
-            }
-            return Core::getDefaultWeights(m_playstyle);
+            return WeightsRegistry::current(m_playstyle).weights;
         }
     };
 } 
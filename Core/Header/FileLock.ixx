@@ -0,0 +1,16 @@
+export module Core.FileLock;
+import <cstdint>;
+import <string>;
+export namespace Core {
+    export class FileLock {
+    public:
+        explicit FileLock(const std::string& path);
+        ~FileLock();
+        FileLock(const FileLock&) = delete;
+        FileLock& operator=(const FileLock&) = delete;
+        bool isLocked() const { return m_locked; }
+    private:
+        std::intptr_t m_file = -1;
+        bool m_locked = false;
+    };
+}
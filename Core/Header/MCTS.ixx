@@ -1,40 +1,97 @@
 export module Core.MCTS;
+import <array>;
+import <atomic>;
 import <vector>;
 import <memory>;
 import <random>;
+import <chrono>;
+import <optional>;
+import <span>;
 import <cstdint>;
-import <unordered_map>;
 import <string>;
+import <bit>;
+import <bitset>;
+import <type_traits>;
+import <utility>;
 import Models.ResourceType;
 import Models.ScientificSymbolType;
 import Models.ColorType;
+import Models.LinkingSymbolType;
+import Models.Card;
 import Core.AIConfig;
+import Core.MCTSArena;
+import Core.TranspositionTable;
+import Core.SearchStats;
+import Core.PositionCache;
 export namespace Core {
+    export constexpr size_t ResourceSlots = static_cast<size_t>(Models::ResourceType::CONDITION_MANUFACTURED_GOODS) + 1;
+    export using ResourceCounts = std::array<uint8_t, ResourceSlots>;
+    export constexpr size_t resourceSlot(Models::ResourceType resource) { return static_cast<size_t>(resource); }
     export struct CardInfo {
         std::string name;
         Models::ColorType color = Models::ColorType::NO_COLOR;
         uint8_t victoryPoints = 0;
         uint8_t shieldPoints = 0;
-        std::unordered_map<Models::ResourceType, uint8_t> resourcesProduction;
-        std::unordered_map<Models::ResourceType, uint8_t> resourceCost;
+        ResourceCounts resourcesProduction{};
+        ResourceCounts resourceCost{};
         bool hasScientificSymbol = false;
         Models::ScientificSymbolType scientificSymbol = Models::ScientificSymbolType::NO_SYMBOL;
-        bool isConstructed = false;
+        uint8_t coinCost = 0;
+        Models::LinkingSymbolType linkingSymbol = Models::LinkingSymbolType::NO_SYMBOL;
+        Models::LinkingSymbolType requiredLinkingSymbol = Models::LinkingSymbolType::NO_SYMBOL;
+        uint8_t fixedPriceResources = 0;
+    };
+    export class MCTSCardCatalog {
+    public:
+        static constexpr uint8_t MaxCards = 255;
+        static constexpr uint8_t NoCard = 255;
+        static uint8_t intern(const Models::Card& card);
+        static const CardInfo& get(uint8_t id);
+    };
+    export struct AgePyramid {
+        static constexpr size_t MaxSlots = 20;
+        std::array<uint8_t, MaxSlots> cardIds{};
+        uint32_t remaining = 0;
+        uint32_t available = 0;
+        uint32_t hidden = 0;
+        bool isEmpty() const { return remaining == 0; }
+        bool isAvailable(size_t slot) const { return slot < MaxSlots && ((available >> slot) & 1u) != 0; }
+    };
+    export struct UnseenCards {
+        static constexpr size_t Pools = 4;
+        static constexpr size_t GuildPool = 3;
+        static constexpr size_t MaxPerPool = 32;
+        std::array<std::array<uint8_t, MaxPerPool>, Pools> cardIds{};
+        std::array<uint8_t, Pools> counts{};
+        void add(size_t pool, uint8_t id) {
+            if (pool < Pools && counts[pool] < MaxPerPool) cardIds[pool][counts[pool]++] = id;
+        }
+    };
+    export struct PyramidTopology {
+        size_t slotCount = 0;
+        std::array<uint32_t, AgePyramid::MaxSlots> childMask{};
+        std::array<uint32_t, AgePyramid::MaxSlots> parentMask{};
     };
     export struct PlayerInfo {
+        static constexpr uint8_t MaxWonders = 4;
         uint8_t coins = 7;
         uint8_t cardCount = 0;
         uint8_t wonderCount = 0;
         uint8_t tokenCount = 0;
-        std::vector<CardInfo> ownedCards;
-        std::vector<CardInfo> ownedWonders;
-        std::unordered_map<Models::ResourceType, uint8_t> permanentResources;
-        std::unordered_map<Models::ResourceType, uint8_t> tradingResources;
-        std::unordered_map<Models::ScientificSymbolType, uint8_t> scientificSymbols;
+        std::array<uint8_t, MaxWonders> wonderIds{};
+        uint8_t constructedWonders = 0;
+        ResourceCounts permanentResources{};
+        ResourceCounts tradingResources{};
+        ResourceCounts brownGreyProduction{};
+        uint8_t fixedPriceResources = 0;
+        std::array<uint8_t, 3> linkingSymbols{};
+        std::array<uint8_t, 2> progressTokens{};
+        uint8_t scientificSymbols = 0;
         uint8_t militaryVP = 0;
         uint8_t buildingVP = 0;
         uint8_t wonderVP = 0;
         uint8_t progressVP = 0;
+        uint8_t blueVP = 0;
         uint8_t brownCards = 0;
         uint8_t greyCards = 0;
         uint8_t blueCards = 0;
@@ -42,12 +99,32 @@ export namespace Core {
         uint8_t greenCards = 0;
         uint8_t yellowCards = 0;
         uint8_t purpleCards = 0;
+        bool isWonderConstructed(size_t index) const { return ((constructedWonders >> index) & 1u) != 0; }
+        bool hasScientificSymbol(Models::ScientificSymbolType symbol) const {
+            return ((scientificSymbols >> static_cast<uint8_t>(symbol)) & 1u) != 0;
+        }
+        void addScientificSymbol(Models::ScientificSymbolType symbol) {
+            scientificSymbols |= static_cast<uint8_t>(1u << static_cast<uint8_t>(symbol));
+        }
+        int scientificSymbolCount() const { return std::popcount(scientificSymbols); }
+        bool hasLinkingSymbol(Models::LinkingSymbolType symbol) const {
+            const auto bit = static_cast<size_t>(symbol);
+            return ((linkingSymbols[bit / 8] >> (bit % 8)) & 1u) != 0;
+        }
+        void addLinkingSymbol(Models::LinkingSymbolType symbol) {
+            const auto bit = static_cast<size_t>(symbol);
+            linkingSymbols[bit / 8] |= static_cast<uint8_t>(1u << (bit % 8));
+        }
+        bool hasProgressToken(size_t token) const { return ((progressTokens[token / 8] >> (token % 8)) & 1u) != 0; }
+        void addProgressToken(size_t token) { progressTokens[token / 8] |= static_cast<uint8_t>(1u << (token % 8)); }
+        bool hasFixedPrice(size_t resource) const { return ((fixedPriceResources >> resource) & 1u) != 0; }
     };
+    static_assert(std::has_unique_object_representations_v<PlayerInfo>);
     export struct MCTSAction {
-        size_t cardNodeIndex = 0;
-        int actionType = 0;
-        size_t wonderIndex = 0;
-        std::string cardName;
+        uint8_t cardNodeIndex = 0;
+        uint8_t actionType = 0;
+        uint8_t wonderIndex = 0;
+        uint8_t cardId = MCTSCardCatalog::NoCard;
         Models::ColorType cardColor = Models::ColorType::NO_COLOR;
         uint8_t expectedVP = 0;
         bool blocksOpponent = false;
@@ -57,25 +134,52 @@ export namespace Core {
                    wonderIndex == other.wonderIndex;
         }
     };
+    export struct ActionList {
+        static constexpr size_t MaxActions = 48;
+        std::array<MCTSAction, MaxActions> items{};
+        uint8_t count = 0;
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+        void clear() { count = 0; }
+        void push_back(const MCTSAction& action) { if (count < MaxActions) items[count++] = action; }
+        MCTSAction& operator[](size_t index) { return items[index]; }
+        const MCTSAction& operator[](size_t index) const { return items[index]; }
+        MCTSAction* begin() { return items.data(); }
+        MCTSAction* end() { return items.data() + count; }
+        const MCTSAction* begin() const { return items.data(); }
+        const MCTSAction* end() const { return items.data() + count; }
+    };
+    export enum class EvalFeature : uint8_t {
+        COINS,
+        CARDS,
+        BLUE_CARDS,
+        GREEN_CARDS,
+        RED_CARDS,
+        YELLOW_CARDS,
+        BUILDING_VP,
+        WONDER_VP,
+        RESOURCES,
+        SCIENCE_TYPES,
+        MILITARY,
+        COUNT
+    };
+    export constexpr size_t EvalFeatureCount = static_cast<size_t>(EvalFeature::COUNT);
+    export using FeatureVector = std::array<int16_t, EvalFeatureCount>;
+    export using FeatureWeights = std::array<double, EvalFeatureCount>;
     export struct MCTSGameState {
         PlayerInfo player1;
         PlayerInfo player2;
-        int militaryPosition = 9;
-        int currentPhase = 1;
+        int8_t militaryPosition = 9;
+        uint8_t currentPhase = 1;
         bool player1Turn = true;
-        int roundsRemaining = 20;
+        int8_t roundsRemaining = 20;
         bool gameOver = false;
-        int winner = -1;
-        std::vector<MCTSAction> availableActions;
-        std::string serializedState;
-        MCTSGameState clone() const {
-            MCTSGameState copy = *this;
-            copy.availableActions = this->availableActions;
-            copy.serializedState = this->serializedState;
-            copy.player1 = this->player1;
-            copy.player2 = this->player2;
-            return copy;
-        }
+        int8_t winner = -1;
+        uint64_t hash = 0;
+        FeatureVector features{};
+        std::array<AgePyramid, 3> pyramids{};
+        ActionList availableActions;
+        MCTSGameState clone() const { return *this; }
         bool isTerminal() const { return gameOver || roundsRemaining <= 0; }
         const PlayerInfo& getCurrentPlayer() const {
             return player1Turn ? player1 : player2;
@@ -89,60 +193,259 @@ export namespace Core {
         PlayerInfo& getOpponentMut() {
             return player1Turn ? player2 : player1;
         }
+        const AgePyramid* getCurrentPyramid() const {
+            if (currentPhase < 1 || currentPhase > 3) return nullptr;
+            return &pyramids[currentPhase - 1];
+        }
+    };
+    static_assert(std::is_trivially_copyable_v<MCTSGameState>);
+    export struct ProgressiveWidening {
+        bool enabled = true;
+        double constant = 1.0;
+        double exponent = 0.5;
+        size_t childLimit(int visits, size_t actionCount) const;
+    };
+    export enum class PlayoutPolicy : uint8_t {
+        RANDOM,
+        EPSILON_GREEDY,
+        SOFTMAX
+    };
+    export struct PlayoutSettings {
+        PlayoutPolicy policy = PlayoutPolicy::EPSILON_GREEDY;
+        double epsilon = 0.25;
+        double temperature = 1.0;
+        size_t choose(const MCTSGameState& state, std::mt19937& rng) const;
+    };
+    export enum class SelectionRule : uint8_t {
+        UCB1,
+        UCB1_TUNED,
+        PUCT
+    };
+    export enum class EvaluatorKind : uint8_t {
+        AUTO,
+        WEIGHTED,
+        LEARNED
+    };
+    export enum class RootPolicy : uint8_t {
+        TREE,
+        SEQUENTIAL_HALVING
+    };
+    export struct SearchPolicy {
+        static constexpr size_t DefaultRootCandidates = 16;
+        SelectionRule selection = SelectionRule::UCB1;
+        EvaluatorKind evaluator = EvaluatorKind::AUTO;
+        RootPolicy root = RootPolicy::TREE;
+        size_t rootCandidates = DefaultRootCandidates;
+    };
+    export struct MemoryLimit {
+        size_t maxNodes = 0;
+        size_t maxBytes = 0;
+        double retainFraction = 0.5;
+        bool isBounded() const { return maxNodes > 0 || maxBytes > 0; }
+    };
+    export struct RaveSettings {
+        bool enabled = false;
+        double equivalence = 300.0;
+        double beta(int visits) const;
+    };
+    export struct AmafTrace {
+        static constexpr size_t Keys = (static_cast<size_t>(MCTSCardCatalog::MaxCards) + 1) * 3;
+        std::array<std::bitset<Keys>, 2> played{};
+        static size_t key(const MCTSAction& action) { return static_cast<size_t>(action.cardId) * 3 + action.actionType % 3; }
+        void record(bool player1, const MCTSAction& action) { played[player1 ? 0 : 1].set(key(action)); }
+        bool contains(bool player1, const MCTSAction& action) const { return played[player1 ? 0 : 1].test(key(action)); }
+        void clear() { played[0].reset(); played[1].reset(); }
+    };
+    export enum class ProvenValue : int8_t {
+        LOSS = -1,
+        UNKNOWN = 0,
+        WIN = 1
+    };
+    export struct ChildStatistics {
+        int32_t* visits = nullptr;
+        int32_t* pending = nullptr;
+        double* values = nullptr;
+        double* squares = nullptr;
+        double* priors = nullptr;
+        uint64_t* hashes = nullptr;
+        ProvenValue* proven = nullptr;
+        uint8_t* order = nullptr;
+        bool isAllocated() const { return visits != nullptr; }
+        void allocate(MCTSArena& arena, size_t capacity) {
+            visits = arena.allocateArray<int32_t>(capacity);
+            pending = arena.allocateArray<int32_t>(capacity);
+            values = arena.allocateArray<double>(capacity);
+            squares = arena.allocateArray<double>(capacity);
+            priors = arena.allocateArray<double>(capacity);
+            hashes = arena.allocateArray<uint64_t>(capacity);
+            proven = arena.allocateArray<ProvenValue>(capacity);
+            order = arena.allocateArray<uint8_t>(capacity);
+        }
     };
     export class MCTSNode {
     public:
-        MCTSNode(const MCTSGameState& state, MCTSNode* parent = nullptr, const MCTSAction& action = MCTSAction{});
+        MCTSNode(MCTSGameState state, MCTSNode* parent = nullptr, const MCTSAction& action = MCTSAction{});
         ~MCTSNode() = default;
-        MCTSNode* select(double explorationConstant);
-        MCTSNode* expand();
-        double simulate(std::mt19937& rng, int maxDepth);
-        void backpropagate(double reward);
-        double getUCB1Score(double explorationConstant) const;
+        MCTSNode(const MCTSNode&) = delete;
+        MCTSNode& operator=(const MCTSNode&) = delete;
+        MCTSNode* expand(MCTSArena& arena, int virtualLoss = 0, const ProgressiveWidening* widening = nullptr);
+        static MCTSNode* cloneSubtree(const MCTSNode& source, MCTSNode* parent, MCTSArena& arena,
+                                      const MCTSGameState* rootState = nullptr, int minVisits = 0);
+        template<typename Selection>
+        MCTSNode* descend(double explorationConstant, int virtualLoss, const TranspositionTable* table,
+                          const ProgressiveWidening* widening, const RaveSettings* rave);
+        template<typename Playout, typename Evaluator>
+        double rollout(std::mt19937& rng, int maxDepth, const Playout& playout, const Evaluator& evaluator,
+                       AmafTrace* trace, int* rolloutLength);
+        void backpropagate(double reward, int virtualLoss = 0, TranspositionTable* table = nullptr, AmafTrace* trace = nullptr);
+        bool seed(const MCTSAction& action, int visits, double meanValue);
+        double getUCB1Score(double explorationConstant, const TranspositionTable* table = nullptr,
+                            const RaveSettings* rave = nullptr) const;
         const MCTSAction& getAction() const { return m_action; }
         const MCTSGameState& getState() const { return m_state; }
-        int getVisits() const { return m_visits; }
-        double getValue() const { return m_totalValue; }
+        const MCTSNode* getParent() const { return m_parent; }
+        int getVisits() const { return m_visits.load(std::memory_order_relaxed); }
+        double getValue() const { return m_totalValue.load(std::memory_order_relaxed); }
+        ProvenValue getProven() const { return m_proven.load(std::memory_order_acquire); }
+        bool isProven() const { return getProven() != ProvenValue::UNKNOWN; }
+        int getAmafVisits() const { return m_amafVisits.load(std::memory_order_relaxed); }
+        double getAmafValue() const { return m_amafValue.load(std::memory_order_relaxed); }
         bool isFullyExpanded() const;
-        bool isLeaf() const { return m_children.empty(); }
-        const std::vector<std::unique_ptr<MCTSNode>>& getChildren() const { return m_children; }
+        bool canExpand(const ProgressiveWidening* widening) const;
+        bool isLeaf() const { return m_childCount.load(std::memory_order_acquire) == 0; }
+        std::span<MCTSNode* const> getChildren() const {
+            return { m_children, m_childCount.load(std::memory_order_acquire) };
+        }
+        const ChildStatistics& getChildStatistics() const { return m_childStats; }
     private:
         MCTSGameState m_state;
         MCTSAction m_action;
         MCTSNode* m_parent;
-        std::vector<std::unique_ptr<MCTSNode>> m_children;
-        int m_visits = 0;
-        double m_totalValue = 0.0;
+        MCTSNode** m_children = nullptr;
+        ChildStatistics m_childStats;
+        uint8_t m_slot = 0;
+        std::atomic<size_t> m_childCount{ 0 };
+        std::atomic<int> m_visits{ 0 };
+        std::atomic<int> m_virtualLoss{ 0 };
+        std::atomic<double> m_totalValue{ 0.0 };
+        std::atomic<int> m_amafVisits{ 0 };
+        std::atomic<double> m_amafValue{ 0.0 };
+        std::atomic<ProvenValue> m_proven{ ProvenValue::UNKNOWN };
+        std::atomic<size_t> m_provenLosses{ 0 };
+        std::atomic_flag m_expansionLock;
         size_t m_untriedActionsIndex = 0;
+        void prove(ProvenValue value);
     };
+    static_assert(std::is_trivially_destructible_v<MCTSNode>);
+    struct PonderTask;
     export class MCTS {
     public:
+        static constexpr int DefaultPonderIterations = 100000;
         MCTS();
         MCTS(int iterations = 1000, double explorationConstant = 1.414, int maxSimulationDepth = 50, 
-             Playstyle playstyle = Playstyle::BRITNEY);
+             Playstyle playstyle = Playstyle::BRITNEY, int threadCount = 1);
+        ~MCTS();
         MCTSAction search(const MCTSGameState& rootState);
+        MCTSAction searchFor(const MCTSGameState& rootState, std::chrono::milliseconds budget);
         void setIterations(int iterations) { m_iterations = iterations; }
         void setExplorationConstant(double c) { m_explorationConstant = c; }
         void setMaxDepth(int depth) { m_maxSimulationDepth = depth; }
         void setPlaystyle(Playstyle style) { m_playstyle = style; }
+        void setThreadCount(int threads) { m_threadCount = threads; }
+        void setParallelism(SearchParallelism mode) { m_parallelism = mode; }
+        void setVirtualLoss(int loss) { m_virtualLoss = loss; }
+        void setClockCheckInterval(int iterations) { m_clockCheckInterval = iterations; }
+        void setEarlyStop(bool enabled) { m_earlyStop = enabled; }
+        int getLastIterations() const { return m_lastIterations; }
+        const SearchStats& getLastSearchStats() const { return m_lastStats; }
+        void setSeed(uint32_t seed) { m_rng.seed(seed); }
         Playstyle getPlaystyle() const { return m_playstyle; }
-        static std::vector<MCTSAction> getLegalActions(const MCTSGameState& state, int currentPhase);
+        int getThreadCount() const { return m_threadCount; }
+        SearchParallelism getParallelism() const { return m_parallelism; }
+        void setTreeReuse(bool enabled) { m_treeReuse = enabled; if (!enabled) resetTree(); }
+        static constexpr int DeterminizationPerThread = -1;
+        void setDeterminizations(int count) { m_determinizations = count; }
+        int getDeterminizations() const { return m_determinizations; }
+        bool usesSharedTree() const;
+        void setUnseenCards(const UnseenCards& unseen) { m_unseen = unseen; }
+        bool getTreeReuse() const { return m_treeReuse; }
+        void resetTree() { stopPondering(); m_retainedRoots.clear(); }
+        bool startPondering();
+        void stopPondering();
+        bool isPondering() const { return m_ponder != nullptr; }
+        void setPonderIterations(int iterations) { m_ponderIterations = iterations; }
+        int getPonderedIterations() const { return m_ponderedIterations; }
+        int getReusedVisits() const { return m_reusedVisits; }
+        void setTranspositions(bool enabled) { m_useTranspositions = enabled; }
+        void setProgressiveWidening(const ProgressiveWidening& widening) { m_widening = widening; }
+        const ProgressiveWidening& getProgressiveWidening() const { return m_widening; }
+        void setPlayout(const PlayoutSettings& playout) { m_playout = playout; }
+        const PlayoutSettings& getPlayout() const { return m_playout; }
+        void setRave(const RaveSettings& rave) { m_rave = rave; }
+        const RaveSettings& getRave() const { return m_rave; }
+        void setMemoryLimit(const MemoryLimit& limit) { m_memoryLimit = limit; }
+        const MemoryLimit& getMemoryLimit() const { return m_memoryLimit; }
+        void setPositionCache(std::shared_ptr<PositionCache> cache) { m_positionCache = std::move(cache); }
+        const std::shared_ptr<PositionCache>& getPositionCache() const { return m_positionCache; }
+        void setSearchPolicy(const SearchPolicy& policy) { m_searchPolicy = policy; }
+        const SearchPolicy& getSearchPolicy() const { return m_searchPolicy; }
+        const TranspositionTable* getTranspositionTable() const { return m_transpositions.empty() ? nullptr : m_transpositions[0].get(); }
+        size_t getNodeCount() const;
+        size_t getArenaBytes() const;
+        size_t getArenaReservedBytes() const;
+        static ActionList getLegalActions(const MCTSGameState& state, int currentPhase);
         static void applyAction(MCTSGameState& state, const MCTSAction& action);
         static bool isTerminal(const MCTSGameState& state);
         static int getWinner(const MCTSGameState& state);
         static MCTSGameState cloneState(const MCTSGameState& state);
+        static uint64_t computeHash(const MCTSGameState& state);
+        static uint64_t canonicalHash(const MCTSGameState& state);
+        static FeatureVector computeFeatures(const MCTSGameState& state);
+        static double evaluateFeatures(const MCTSGameState& state, const AIWeights& weights);
+        static int cardCost(const PlayerInfo& player, const PlayerInfo& opponent, const CardInfo& card);
+        static int wonderCost(const PlayerInfo& player, const PlayerInfo& opponent, const CardInfo& wonder);
+        static double evaluateResourceDenial(const MCTSGameState& state, const MCTSAction& action);
+        static double actionPrior(const MCTSGameState& state, const MCTSAction& action);
         static MCTSGameState captureGameState(int currentPhase, bool isPlayer1Turn);
-        static void saveCurrentState(MCTSGameState& mctsState);
-        static void restoreState(const MCTSGameState& mctsState);
+        static UnseenCards captureUnseenCards();
+        static void determinize(MCTSGameState& state, const UnseenCards& unseen, std::mt19937& rng);
+        static const PyramidTopology& getPyramidTopology(int age);
+        static std::string saveCurrentState();
+        static void restoreState(const std::string& serializedState);
     private:
         int m_iterations;
         double m_explorationConstant;
         int m_maxSimulationDepth;
+        int m_threadCount;
+        SearchParallelism m_parallelism;
+        int m_virtualLoss;
+        int m_clockCheckInterval = 64;
+        bool m_earlyStop = true;
+        int m_lastIterations = 0;
+        SearchStats m_lastStats;
         std::mt19937 m_rng;
         Playstyle m_playstyle;
-        double evaluateState(const MCTSGameState& state, bool forPlayer1) const;
-        double evaluateResourceDenial(const MCTSGameState& state, const MCTSAction& action) const;
-        double evaluateScientificProgress(const PlayerInfo& player) const;
-        double evaluateMilitaryPosition(int position, bool forPlayer1) const;
+        std::array<std::vector<std::unique_ptr<MCTSArena>>, 2> m_arenaBanks;
+        size_t m_activeBank = 0;
+        bool m_treeReuse = false;
+        int m_determinizations = 0;
+        UnseenCards m_unseen;
+        std::vector<MCTSNode*> m_retainedRoots;
+        MCTSAction m_lastAction;
+        int m_reusedVisits = 0;
+        bool m_useTranspositions = true;
+        ProgressiveWidening m_widening;
+        PlayoutSettings m_playout;
+        RaveSettings m_rave;
+        SearchPolicy m_searchPolicy;
+        MemoryLimit m_memoryLimit;
+        std::shared_ptr<PositionCache> m_positionCache;
+        std::vector<std::unique_ptr<TranspositionTable>> m_transpositions;
+        std::unique_ptr<PonderTask> m_ponder;
+        int m_ponderIterations = DefaultPonderIterations;
+        int m_ponderedIterations = 0;
+        MCTSAction runSearch(const MCTSGameState& rootState, std::optional<std::chrono::milliseconds> budget);
+        MCTSNode* reuseSubtree(size_t tree, const MCTSGameState& observed, MCTSArena& arena) const;
+        MCTSNode* compactTree(const MCTSNode& root, size_t firstArena, size_t arenaCount, size_t& peakBytes);
     };
 } 
@@ -0,0 +1,56 @@
+export module Core.MCTSArena;
+import <cstddef>;
+import <cstdint>;
+import <memory>;
+import <new>;
+import <type_traits>;
+import <utility>;
+import <vector>;
+export namespace Core {
+    export class MCTSArena {
+    public:
+        static constexpr size_t DefaultBlockSize = 1u << 20;
+        explicit MCTSArena(size_t blockSize = DefaultBlockSize);
+        ~MCTSArena();
+        MCTSArena(const MCTSArena&) = delete;
+        MCTSArena& operator=(const MCTSArena&) = delete;
+        void* allocate(size_t bytes, size_t alignment);
+        template<typename T, typename... Args>
+        T* create(Args&&... args) {
+            T* object = ::new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                m_destructors.push_back({ object, [](void* p) { static_cast<T*>(p)->~T(); } });
+            }
+            ++m_objectCount;
+            return object;
+        }
+        template<typename T>
+        T* allocateArray(size_t count) {
+            static_assert(std::is_trivially_destructible_v<T>, "arena arrays are released without destructors");
+            T* array = static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+            for (size_t i = 0; i < count; ++i) ::new (array + i) T{};
+            return array;
+        }
+        void reset();
+        size_t getObjectCount() const { return m_objectCount; }
+        size_t getAllocatedBytes() const { return m_allocatedBytes; }
+        size_t getReservedBytes() const { return m_reservedBytes; }
+    private:
+        struct Block {
+            std::unique_ptr<std::byte[]> memory;
+            size_t size = 0;
+        };
+        struct Destructor {
+            void* object;
+            void (*destroy)(void*);
+        };
+        std::vector<Block> m_blocks;
+        std::vector<Destructor> m_destructors;
+        size_t m_blockSize;
+        size_t m_currentBlock = 0;
+        size_t m_offset = 0;
+        size_t m_objectCount = 0;
+        size_t m_allocatedBytes = 0;
+        size_t m_reservedBytes = 0;
+    };
+}
@@ -0,0 +1,39 @@
+export module Core.MCTSBenchmark;
+import <vector>;
+import <chrono>;
+import Core.AIConfig;
+import Core.MCTS;
+export namespace Core {
+struct ScalingSample {
+    int threads = 1;
+    double milliseconds = 0.0;
+    double iterationsPerSecond = 0.0;
+    double efficiency = 0.0;
+    size_t nodes = 0;
+    size_t arenaBytes = 0;
+};
+struct StateThroughput {
+    double clonesPerSecond = 0.0;
+    double rolloutsPerSecond = 0.0;
+    double averageRolloutLength = 0.0;
+};
+struct PlayoutMatch {
+    PlayoutPolicy policy = PlayoutPolicy::RANDOM;
+    int games = 0;
+    int wins = 0;
+    int draws = 0;
+    int losses = 0;
+    double candidateIterationsPerMove = 0.0;
+    double baselineIterationsPerMove = 0.0;
+};
+StateThroughput measureStateThroughput(const MCTSGameState& rootState, int clones, int rollouts);
+std::vector<ScalingSample> measureSearchScaling(const MCTSGameState& rootState, SearchParallelism mode,
+                                                int totalIterations, const std::vector<int>& threadCounts);
+PlayoutMatch measurePlayoutPolicy(const MCTSGameState& rootState, const PlayoutSettings& candidate, int games,
+                                  std::chrono::milliseconds moveTime);
+void printThroughputReport(const StateThroughput& throughput);
+void printScalingReport(SearchParallelism mode, const std::vector<ScalingSample>& samples);
+void printPlayoutReport(std::chrono::milliseconds moveTime, const std::vector<PlayoutMatch>& matches);
+bool printTreeParallelCheck(int threads);
+void runMCTSBenchmarks();
+}
@@ -0,0 +1,79 @@
+export module Core.MCTSPolicies;
+import <array>;
+import <cmath>;
+import <cstddef>;
+import <cstdint>;
+import <random>;
+import Core.AIConfig;
+import Core.MCTS;
+export namespace Core {
+    export struct UCB1 {
+        static void score(const ChildStatistics& stats, size_t count, double explorationConstant, int parentVisits,
+                          double* scores);
+    };
+    export struct UCB1Tuned {
+        static void score(const ChildStatistics& stats, size_t count, double explorationConstant, int parentVisits,
+                          double* scores);
+    };
+    export struct PUCT {
+        static constexpr double FirstPlayValue = 0.5;
+        static void score(const ChildStatistics& stats, size_t count, double explorationConstant, int parentVisits,
+                          double* scores);
+    };
+    export struct SequentialHalving {
+        static constexpr double VisitOffset = 50.0;
+        static constexpr double ValueScale = 0.1;
+        static size_t rounds(size_t candidates);
+        static double gumbel(std::mt19937& rng);
+        static double score(double gumbel, double prior, double meanValue, int maxVisits);
+    };
+    export struct RandomPlayout {
+        explicit RandomPlayout(const PlayoutSettings&) {}
+        size_t choose(const MCTSGameState& state, std::mt19937& rng) const {
+            return std::uniform_int_distribution<size_t>(0, state.availableActions.size() - 1)(rng);
+        }
+    };
+    export struct GuidedPlayout {
+        PlayoutSettings settings;
+        explicit GuidedPlayout(const PlayoutSettings& playout) : settings(playout) {}
+        size_t choose(const MCTSGameState& state, std::mt19937& rng) const { return settings.choose(state, rng); }
+    };
+    export constexpr double EvaluationScale = 10.0;
+    export constexpr FeatureWeights toFeatureWeights(const AIWeights& weights) {
+        FeatureWeights result{};
+        auto set = [&result](EvalFeature feature, double value) { result[static_cast<size_t>(feature)] = value; };
+        set(EvalFeature::COINS, weights.coinValue);
+        set(EvalFeature::CARDS, weights.economyPriority);
+        set(EvalFeature::BLUE_CARDS, weights.victoryPointValue);
+        set(EvalFeature::GREEN_CARDS, weights.sciencePriority);
+        set(EvalFeature::RED_CARDS, weights.militaryPriority);
+        set(EvalFeature::YELLOW_CARDS, weights.economyPriority);
+        set(EvalFeature::BUILDING_VP, weights.victoryPointValue);
+        set(EvalFeature::WONDER_VP, weights.wonderVPBonus);
+        set(EvalFeature::RESOURCES, weights.resourceValue);
+        set(EvalFeature::SCIENCE_TYPES, weights.sciencePriority);
+        set(EvalFeature::MILITARY, weights.militaryPriority);
+        return result;
+    }
+    export template<Playstyle Style>
+    struct PlaystyleWeights {
+        static constexpr FeatureWeights coefficients = toFeatureWeights(getDefaultWeights(Style));
+    };
+    export inline double featureValue(const FeatureWeights& coefficients, const FeatureVector& features) {
+        double score = 0.0;
+        for (size_t i = 0; i < EvalFeatureCount; ++i) score += coefficients[i] * features[i];
+        return 1.0 / (1.0 + std::exp(-score / EvaluationScale));
+    }
+    export template<Playstyle Style>
+    struct WeightedEvaluator {
+        explicit WeightedEvaluator(const FeatureWeights&) {}
+        double operator()(const MCTSGameState& state) const {
+            return featureValue(PlaystyleWeights<Style>::coefficients, state.features);
+        }
+    };
+    export struct LearnedEvaluator {
+        FeatureWeights coefficients;
+        explicit LearnedEvaluator(const FeatureWeights& learned) : coefficients(learned) {}
+        double operator()(const MCTSGameState& state) const { return featureValue(coefficients, state.features); }
+    };
+}
@@ -3,8 +3,12 @@ import <vector>;
 import <cstdint>;
 import <memory>;
 import <string>;
+import <chrono>;
 import Core.AIConfig;
 import Core.MCTS;
+import Core.SearchStats;
+import Core.ThinkTimeManager;
+import Core.PositionCache;
 export namespace Core {
     struct IPlayerDecisionMaker {
         virtual ~IPlayerDecisionMaker() = default;
@@ -27,8 +31,13 @@ export namespace Core {
         MCTSDecisionMaker(Playstyle playstyle = Playstyle::BRITNEY, 
                           int iterations = 1000, 
                           double explorationConstant = 1.414,
-                          int maxDepth = 20);
+                          int maxDepth = 20,
+                          int threadCount = 1);
+        explicit MCTSDecisionMaker(const AIConfig& config);
         ~MCTSDecisionMaker();
+        static std::unique_ptr<MCTSDecisionMaker> create(const AIConfig& config, SelectionRule selection,
+                                                         PlayoutPolicy playout = PlayoutPolicy::EPSILON_GREEDY,
+                                                         EvaluatorKind evaluator = EvaluatorKind::AUTO);
         size_t selectCard(const std::vector<size_t>& available) override;
         int selectCardAction() override;
         size_t selectWonder(const std::vector<size_t>& candidates) override;
@@ -42,13 +51,34 @@ export namespace Core {
         void setIterations(int count);
         void setExplorationConstant(double constant);
         void setMaxDepth(int depth);
+        void setThreadCount(int threads);
+        void setSeed(uint32_t seed);
+        void setParallelism(SearchParallelism mode);
+        void setTreeReuse(bool enabled);
+        void setTimeBudget(std::chrono::milliseconds budget);
+        void setGameTimeBudget(std::chrono::milliseconds budget);
+        void startGame();
+        void setPositionCache(std::shared_ptr<PositionCache> cache);
+        void setPondering(bool enabled);
+        void setSearchPolicy(const SearchPolicy& policy);
+        void setPlayoutPolicy(PlayoutPolicy policy);
+        bool getPondering() const;
         Playstyle getPlaystyle() const;
+        int getThreadCount() const;
+        bool usesSharedTree() const;
+        const SearchStats& getLastSearchStats() const;
+        const ThinkTimeManager& getThinkTimeManager() const;
     private:
         std::unique_ptr<MCTS> m_mcts;
         Playstyle m_playstyle;
         int m_iterations;
         double m_explorationConstant;
         int m_maxDepth;
+        int m_threadCount;
+        std::chrono::milliseconds m_timeBudget{ 0 };
+        ThinkTimeManager m_thinkTime;
+        SearchStats m_lastStats;
+        bool m_pondering = false;
     };
     struct HumanAssistedDecisionMaker : IPlayerDecisionMaker {
         HumanAssistedDecisionMaker(Playstyle suggestionStyle = Playstyle::BRITNEY,
@@ -82,6 +112,7 @@ export namespace Core {
         void setSimulationCount(unsigned int count);
         void setExplorationConstant(double constant);
         void setMaxDepth(unsigned int depth);
+        const SearchStats& getLastSearchStats() const;
     private:
         std::unique_ptr<MCTS> m_mcts;
         unsigned int m_simulationCount = 1000;
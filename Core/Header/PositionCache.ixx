@@ -0,0 +1,52 @@
+export module Core.PositionCache;
+import <array>;
+import <cstddef>;
+import <cstdint>;
+import <mutex>;
+import <optional>;
+import <string>;
+export namespace Core {
+    export struct CachedAction {
+        uint8_t cardNodeIndex = 0;
+        uint8_t actionType = 0;
+        uint8_t wonderIndex = 0;
+        uint8_t reserved = 0;
+        uint32_t visits = 0;
+        float value = 0.0f;
+    };
+    export struct CachedRoot {
+        static constexpr size_t MaxActions = 16;
+        uint32_t visits = 0;
+        float value = 0.5f;
+        uint8_t actionCount = 0;
+        std::array<uint8_t, 3> reserved{};
+        std::array<CachedAction, MaxActions> actions{};
+    };
+    export struct PositionCacheSettings {
+        std::string path = "position_cache.bin";
+        size_t capacity = size_t{ 1 } << 16;
+        size_t ways = 8;
+    };
+    export class PositionCache {
+    public:
+        explicit PositionCache(PositionCacheSettings settings = {});
+        ~PositionCache();
+        PositionCache(const PositionCache&) = delete;
+        PositionCache& operator=(const PositionCache&) = delete;
+        bool isOpen() const { return m_view != nullptr; }
+        std::optional<CachedRoot> lookup(uint64_t key);
+        void store(uint64_t key, const CachedRoot& root);
+        size_t size();
+        size_t capacity() const { return m_buckets * m_settings.ways; }
+        const PositionCacheSettings& getSettings() const { return m_settings; }
+    private:
+        PositionCacheSettings m_settings;
+        size_t m_buckets = 0;
+        size_t m_bytes = 0;
+        std::intptr_t m_file = -1;
+        std::intptr_t m_mapping = 0;
+        std::byte* m_view = nullptr;
+        std::mutex m_mutex;
+        size_t bucketOffset(uint64_t key) const;
+    };
+}
@@ -0,0 +1,39 @@
+export module Core.SearchStats;
+import <array>;
+import <cstddef>;
+import <cstdint>;
+import <string>;
+export namespace Core {
+    export struct SearchStats {
+        static constexpr size_t RolloutBuckets = 8;
+        static constexpr int RolloutBucketWidth = 8;
+        static constexpr int PhaseSampleInterval = 16;
+        int iterations = 0;
+        double wallMs = 0.0;
+        double iterationsPerSecond = 0.0;
+        int maxTreeDepth = 0;
+        long long totalTreeDepth = 0;
+        size_t nodesAllocated = 0;
+        size_t bytesUsed = 0;
+        size_t peakBytes = 0;
+        int compactions = 0;
+        int reusedVisits = 0;
+        int ponderedIterations = 0;
+        std::array<int, RolloutBuckets> rolloutLengths{};
+        int timedIterations = 0;
+        double selectMs = 0.0;
+        double expandMs = 0.0;
+        double simulateMs = 0.0;
+        double backpropagateMs = 0.0;
+        int bestVisits = 0;
+        int bestNewVisits = 0;
+        double rootValue = 0.5;
+        double bestValue = 0.5;
+        bool provenWin = false;
+        double averageTreeDepth() const;
+        void recordIteration(int treeDepth, int rolloutLength);
+        void merge(const SearchStats& other);
+        void extrapolatePhaseTimes();
+        std::string rolloutHistogram() const;
+    };
+}
@@ -0,0 +1,32 @@
+export module Core.ThinkTimeManager;
+import <chrono>;
+import <cstddef>;
+import Core.MCTS;
+import Core.SearchStats;
+export namespace Core {
+    export struct ThinkTimeSettings {
+        std::chrono::milliseconds gameBudget{ 0 };
+        std::chrono::milliseconds minimumMove{ 2 };
+        double maximumShare = 0.25;
+        double typicalBranching = 12.0;
+        int criticalMilitaryDistance = 3;
+        int criticalScienceSymbols = 5;
+    };
+    export class ThinkTimeManager {
+    public:
+        explicit ThinkTimeManager(ThinkTimeSettings settings = {});
+        void startGame();
+        bool isEnabled() const { return m_settings.gameBudget.count() > 0; }
+        bool isForced(const MCTSGameState& state) const;
+        bool isCritical(const MCTSGameState& state) const;
+        std::chrono::milliseconds allocate(const MCTSGameState& state) const;
+        void record(std::chrono::milliseconds spent, const SearchStats& stats);
+        std::chrono::milliseconds getRemaining() const { return m_remaining; }
+        double getStability() const { return m_stability; }
+        const ThinkTimeSettings& getSettings() const { return m_settings; }
+    private:
+        ThinkTimeSettings m_settings;
+        std::chrono::milliseconds m_remaining{ 0 };
+        double m_stability = 0.5;
+    };
+}
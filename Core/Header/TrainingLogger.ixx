@@ -7,6 +7,7 @@ import <chrono>;
 import <sstream>;
 import <iomanip>;
 import Core.AIConfig;
+import Core.SearchStats;
 export namespace Core {
     struct MCTSGameState;
     struct MCTSAction;
@@ -32,6 +33,7 @@ export namespace Core {
         int cardNodeIndex;
         double stateValue;          
         double expectedReward;      
+        SearchStats search;
         TurnRecord() : turnNumber(0), player1Turn(true), currentPhase(1), militaryPosition(9),
                        p1Coins(7), p1Cards(0), p1Wonders(0), p1BlueCards(0), p1GreenCards(0), p1RedCards(0),
                        p2Coins(7), p2Cards(0), p2Wonders(0), p2BlueCards(0), p2GreenCards(0), p2RedCards(0),
@@ -70,5 +72,5 @@ export namespace Core {
         void reset();
     };
     TurnRecord createTurnRecord(const MCTSGameState& state, const MCTSAction& action, 
-                                int turnNum, double stateValue, double expectedReward);
+                                int turnNum, const SearchStats& search);
 } 
@@ -0,0 +1,36 @@
+export module Core.TranspositionTable;
+import <atomic>;
+import <cstddef>;
+import <cstdint>;
+import <memory>;
+export namespace Core {
+    export struct TranspositionStats {
+        uint32_t visits = 0;
+        double totalValue = 0.0;
+    };
+    export class TranspositionTable {
+    public:
+        static constexpr size_t BucketSize = 4;
+        static constexpr size_t DefaultEntries = 1u << 16;
+        explicit TranspositionTable(size_t entries = DefaultEntries);
+        TranspositionTable(const TranspositionTable&) = delete;
+        TranspositionTable& operator=(const TranspositionTable&) = delete;
+        void record(uint64_t key, double reward);
+        bool probe(uint64_t key, TranspositionStats& stats) const;
+        void newSearch() { m_generation.fetch_add(1, std::memory_order_relaxed); }
+        void clear();
+        size_t getCapacity() const { return m_bucketCount * BucketSize; }
+        size_t getMemoryBytes() const { return getCapacity() * sizeof(Entry); }
+    private:
+        struct Entry {
+            std::atomic<uint64_t> key{ 0 };
+            std::atomic<uint32_t> visits{ 0 };
+            std::atomic<uint32_t> generation{ 0 };
+            std::atomic<double> totalValue{ 0.0 };
+        };
+        Entry* bucketFor(uint64_t key) const { return &m_entries[(key & (m_bucketCount - 1)) * BucketSize]; }
+        std::unique_ptr<Entry[]> m_entries;
+        size_t m_bucketCount;
+        std::atomic<uint32_t> m_generation{ 1 };
+    };
+}
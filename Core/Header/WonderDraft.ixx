@@ -0,0 +1,52 @@
+export module Core.WonderDraft;
+import <chrono>;
+import <cstdint>;
+import <random>;
+import <string>;
+import <unordered_map>;
+import <vector>;
+import Core.AIConfig;
+import Core.MCTS;
+export namespace Core {
+    export struct DraftPick {
+        MCTSGameState base;
+        std::vector<uint8_t> offered;
+        std::vector<bool> order;
+        std::vector<uint8_t> reserve;
+        std::vector<bool> laterOrder;
+        bool picker() const { return order.empty() || order.front(); }
+    };
+    export struct DraftSettings {
+        std::chrono::milliseconds budget{ 250 };
+        int threadCount = 0;
+        int batchSize = 16;
+        int cachedGames = 2000;
+        int maxPlies = 200;
+        std::string cachePath = "wonder_draft_cache.csv";
+    };
+    export class WonderDraftEvaluator {
+    public:
+        explicit WonderDraftEvaluator(Playstyle playstyle = Playstyle::BRITNEY, DraftSettings settings = {});
+        size_t choose(const DraftPick& pick);
+        std::vector<double> evaluate(const DraftPick& pick);
+        void setSeed(uint32_t seed) { m_rng.seed(seed); }
+        int getLastGames() const { return m_lastGames; }
+        bool getLastCacheHit() const { return m_lastCacheHit; }
+        static std::string cacheKey(const DraftPick& pick);
+    private:
+        struct Tally {
+            double wins = 0.0;
+            int games = 0;
+        };
+        using CacheEntry = std::unordered_map<std::string, Tally>;
+        Playstyle m_playstyle;
+        DraftSettings m_settings;
+        std::mt19937 m_rng;
+        std::unordered_map<std::string, CacheEntry> m_cache;
+        std::unordered_map<std::string, CacheEntry> m_pending;
+        int m_lastGames = 0;
+        bool m_lastCacheHit = false;
+        void loadCache();
+        void saveCache();
+    };
+}
@@ -0,0 +1,108 @@
+module Core.AIConfig;
+import <array>;
+import <atomic>;
+import <filesystem>;
+import <memory>;
+import <mutex>;
+import <string>;
+import <vector>;
+namespace Core {
+namespace {
+    constexpr size_t PlaystyleCount = static_cast<size_t>(Playstyle::SPEARS) + 1;
+    struct WeightsSlot {
+        std::atomic<const WeightsSnapshot*> current{ nullptr };
+        std::atomic<uint32_t> readers{ 0 };
+        std::vector<std::unique_ptr<const WeightsSnapshot>> retired;
+        std::filesystem::file_time_type lastWriteTime{};
+        bool hasFile = false;
+        ~WeightsSlot() { delete current.load(); }
+    };
+    struct WeightsStorage {
+        std::array<WeightsSlot, PlaystyleCount> slots;
+        std::mutex mutex;
+        uint64_t nextVersion = 1;
+        std::atomic<bool> hotReload{ false };
+    };
+    WeightsSlot& slotFor(WeightsStorage& storage, Playstyle style) {
+        return storage.slots[static_cast<size_t>(style)];
+    }
+    const WeightsSnapshot* install(WeightsStorage& storage, Playstyle style, const AIWeights& weights, bool fromFile) {
+        auto snapshot = std::make_unique<WeightsSnapshot>();
+        snapshot->playstyle = style;
+        snapshot->weights = weights;
+        snapshot->version = storage.nextVersion++;
+        snapshot->loadedFromFile = fromFile;
+        WeightsSlot& slot = slotFor(storage, style);
+        const WeightsSnapshot* installed = snapshot.release();
+        if (const WeightsSnapshot* previous = slot.current.exchange(installed)) slot.retired.emplace_back(previous);
+        if (slot.readers.load() == 0) slot.retired.clear();
+        return installed;
+    }
+    const WeightsSnapshot* loadFromDisk(WeightsStorage& storage, Playstyle style) {
+        WeightsSlot& slot = slotFor(storage, style);
+        const std::string path = WeightsRegistry::weightsPath(style);
+        std::error_code error;
+        auto writeTime = std::filesystem::last_write_time(path, error);
+        if (!error) {
+            AIWeights weights;
+            try {
+                if (weights.loadFromFile(path)) {
+                    slot.hasFile = true;
+                    slot.lastWriteTime = writeTime;
+                    return install(storage, style, weights, true);
+                }
+            } catch (const std::exception&) {
+            }
+        }
+        if (const WeightsSnapshot* previous = slot.current.load(std::memory_order_relaxed)) {
+            return previous;
+        }
+        return install(storage, style, getDefaultWeights(style), false);
+    }
+    WeightsStorage& weightsStorage() {
+        static WeightsStorage storage;
+        [[maybe_unused]] static const bool loaded = [] {
+            std::lock_guard<std::mutex> lock(storage.mutex);
+            for (size_t style = 0; style < PlaystyleCount; ++style) loadFromDisk(storage, static_cast<Playstyle>(style));
+            return true;
+        }();
+        return storage;
+    }
+}
+WeightsSnapshot WeightsRegistry::current(Playstyle style) {
+    WeightsSlot& slot = slotFor(weightsStorage(), style);
+    slot.readers.fetch_add(1);
+    WeightsSnapshot snapshot = *slot.current.load();
+    slot.readers.fetch_sub(1);
+    return snapshot;
+}
+WeightsSnapshot WeightsRegistry::publish(Playstyle style, const AIWeights& weights) {
+    auto& storage = weightsStorage();
+    std::lock_guard<std::mutex> lock(storage.mutex);
+    return *install(storage, style, weights, false);
+}
+bool WeightsRegistry::reloadIfChanged(Playstyle style) {
+    auto& storage = weightsStorage();
+    std::lock_guard<std::mutex> lock(storage.mutex);
+    WeightsSlot& slot = slotFor(storage, style);
+    const uint64_t before = slot.current.load(std::memory_order_relaxed)->version;
+    std::error_code error;
+    auto writeTime = std::filesystem::last_write_time(weightsPath(style), error);
+    if (error || (slot.hasFile && writeTime == slot.lastWriteTime)) return false;
+    return loadFromDisk(storage, style)->version != before;
+}
+void WeightsRegistry::reloadAllIfChanged() {
+    for (size_t style = 0; style < PlaystyleCount; ++style) {
+        reloadIfChanged(static_cast<Playstyle>(style));
+    }
+}
+void WeightsRegistry::setHotReload(bool enabled) {
+    weightsStorage().hotReload.store(enabled, std::memory_order_relaxed);
+}
+bool WeightsRegistry::isHotReloadEnabled() {
+    return weightsStorage().hotReload.load(std::memory_order_relaxed);
+}
+std::string WeightsRegistry::weightsPath(Playstyle style) {
+    return "OptimizedWeights/" + playstyleToString(style) + "_optimized.weights";
+}
+}
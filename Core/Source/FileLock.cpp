@@ -0,0 +1,45 @@
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+module Core.FileLock;
+import <cstdint>;
+import <string>;
+using namespace Core;
+FileLock::FileLock(const std::string& path) {
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return;
+    m_file = reinterpret_cast<std::intptr_t>(file);
+    OVERLAPPED overlapped{};
+    m_locked = LockFileEx(file, LOCKFILE_EXCLUSIVE_LOCK, 0, MAXDWORD, MAXDWORD, &overlapped) != 0;
+#else
+    const int file = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (file < 0) return;
+    m_file = file;
+    struct flock lock{};
+    lock.l_type = F_WRLCK;
+    lock.l_whence = SEEK_SET;
+    int result = 0;
+    while ((result = fcntl(file, F_SETLKW, &lock)) == -1 && errno == EINTR) {}
+    m_locked = result == 0;
+#endif
+}
+FileLock::~FileLock() {
+    if (m_file == -1) return;
+#if defined(_WIN32)
+    if (m_locked) {
+        OVERLAPPED overlapped{};
+        UnlockFileEx(reinterpret_cast<HANDLE>(m_file), 0, MAXDWORD, MAXDWORD, &overlapped);
+    }
+    CloseHandle(reinterpret_cast<HANDLE>(m_file));
+#else
+    close(static_cast<int>(m_file));
+#endif
+}
@@ -12,9 +12,13 @@ import <sstream>;
 import <functional>;
 import <memory>;
 import <optional>;
+import <chrono>;
 import Core.PlayerDecisionMaker;
 import Core.TrainingLogger;
 import Core.MCTS;
+import Core.WonderDraft;
+import Core.SearchStats;
+import Core.PositionCache;
 import Core.GameStateSerializer;
 import Models.AgeCard;
 import Models.GuildCard;
@@ -42,6 +46,7 @@ namespace Core {
 		std::unique_ptr<std::vector<std::unique_ptr<Models::Token>>> setupUnusedProgressTokens;
 		const int kNrOfRounds = 20;
 		const std::vector<int> kMilitaryTokenPositions = { 2,5,8,11,14,17 };
+		const std::chrono::milliseconds kTrainingGameTimeBudget{ 250 };
 		bool g_last_active_was_player_one = true;
 		std::mt19937_64 make_rng(uint32_t seed) {
 			return std::mt19937_64(seed);
@@ -964,14 +969,14 @@ namespace Core {
 		notifier.notifyDisplayRequested(headerEvent);
 		displayAvailableWonders(availableWonders);
 
+		auto roundOrder = [](bool startWithP1) {
+			return startWithP1 ? std::vector<bool>{ true, false, false, true } : std::vector<bool>{ false, true, true, false };
+		};
+		std::optional<WonderDraftEvaluator> draftEvaluator;
+
 		auto draftWonders = [&](bool startWithP1) {
-			std::vector<bool> playerOrder;
-			if (startWithP1) {
-				playerOrder = { true, false, false, true };
-			}
-			else {
-				playerOrder = { false, true, true, false };
-			}
+			std::vector<bool> playerOrder = roundOrder(startWithP1);
+			const bool firstRound = startWithP1 == player1Starts;
 
 			for (size_t i = 0; i < playerOrder.size(); ++i) {
 				if (availableWonders.empty()) break;
@@ -1003,38 +1008,23 @@ namespace Core {
 
 				size_t choice = 0;
 				if (auto* mctsDM = dynamic_cast<MCTSDecisionMaker*>(decisionMaker)) {
-					AIConfig cfg(mctsDM->getPlaystyle());
-					const auto w = cfg.getWeights();
-
-					auto scoreWonder = [&](const Models::Wonder& wonder) -> double {
-						double score = 0.0;
-						score += static_cast<double>(wonder.getVictoryPoints()) * w.victoryPointValue * w.wonderVPBonus;
-						score += static_cast<double>(wonder.getShieldPoints()) * w.militaryPriority * w.wonderMilitaryBonus;
-						if (wonder.getResourceProduction() != Models::ResourceType::NO_RESOURCE) {
-							score += 1.0 * w.resourceValue;
-						}
-						for (const auto& [res, amt] : wonder.getResourceCost()) {
-							(void)res;
-							score -= static_cast<double>(amt) * w.resourceValue * 0.5;
-						}
-						for (const auto& act : wonder.getOnPlayActions()) {
-							const std::string& label = act.second;
-							if (label.find("takeNewCard") != std::string::npos) score += 1.0 * w.economyPriority;
-							if (label.find("drawToken") != std::string::npos) score += 1.0 * w.sciencePriority;
-							if (label.find("discard") != std::string::npos) score += 1.0 * w.opponentDenial;
-							if (label.find("playAnotherTurn") != std::string::npos) score += 1.0 * w.wonderEconomyBonus;
-						}
-						return score;
-					};
-
-					double bestScore = -1e18;
-					for (size_t j = 0; j < availableWonders.size(); ++j) {
-						if (!availableWonders[j]) continue;
-						double s = scoreWonder(*availableWonders[j]);
-						if (s > bestScore) {
-							bestScore = s;
-							choice = j;
+					if (!draftEvaluator) draftEvaluator.emplace(mctsDM->getPlaystyle());
+					DraftPick pick;
+					pick.base = MCTS::captureGameState(1, isPlayer1);
+					for (const auto& wonder : availableWonders) {
+						if (wonder) pick.offered.push_back(MCTSCardCatalog::intern(*wonder));
+					}
+					pick.order.assign(playerOrder.begin() + static_cast<std::ptrdiff_t>(i), playerOrder.end());
+					if (firstRound) {
+						for (const auto& card : wondersPool) {
+							if (auto* wonder = dynamic_cast<const Models::Wonder*>(card.get())) {
+								pick.reserve.push_back(MCTSCardCatalog::intern(*wonder));
+							}
 						}
+						pick.laterOrder = roundOrder(!startWithP1);
+					}
+					if (pick.offered.size() == availableWonders.size()) {
+						choice = draftEvaluator->choose(pick);
 					}
 				}
 				else {
@@ -1193,6 +1183,12 @@ namespace Core {
 		IPlayerDecisionMaker& p2Decisions,
 		std::optional<std::reference_wrapper<TrainingLogger>> logger)
 	{
+		if (WeightsRegistry::isHotReloadEnabled()) {
+			WeightsRegistry::reloadAllIfChanged();
+		}
+		for (IPlayerDecisionMaker* decisions : { &p1Decisions, &p2Decisions }) {
+			if (auto* mctsDM = dynamic_cast<MCTSDecisionMaker*>(decisions)) mctsDM->startGame();
+		}
 		GameState& gameState = GameState::getInstance();
 		auto& notifier = gameState.getEventNotifier();
 		auto& board = Board::getInstance();
@@ -1292,10 +1288,12 @@ namespace Core {
 				int action = 0;
 				std::optional<size_t> mctsWonderOwnedIndex = std::nullopt;
 				bool isMctsDriven = false;
+				SearchStats searchStats;
 
 				if (auto* mctsDM = dynamic_cast<MCTSDecisionMaker*>(&curDecisionMaker)) {
 					isMctsDriven = true;
 					MCTSAction mctsAction = mctsDM->selectTurnAction();
+					searchStats = mctsDM->getLastSearchStats();
 					chosenNodeIndex = mctsAction.cardNodeIndex;
 					action = mctsAction.actionType;
 					mctsWonderOwnedIndex = mctsAction.wonderIndex;
@@ -1307,6 +1305,7 @@ namespace Core {
 				else if (auto* aiDM = dynamic_cast<AIDecisionMaker*>(&curDecisionMaker)) {
 					isMctsDriven = true;
 					MCTSAction mctsAction = aiDM->selectTurnAction();
+					searchStats = aiDM->getLastSearchStats();
 					chosenNodeIndex = mctsAction.cardNodeIndex;
 					action = mctsAction.actionType;
 					mctsWonderOwnedIndex = mctsAction.wonderIndex;
@@ -1331,6 +1330,7 @@ namespace Core {
 				}
 
 				std::string cardName = cardPtr->getName();
+				const uint8_t cardCatalogId = logger ? MCTSCardCatalog::intern(*cardPtr) : MCTSCardCatalog::NoCard;
 				displayCardDetails(*cardPtr);
 				uint8_t shields = getShieldPointsFromCard(*cardPtr, std::cref(cur));
 
@@ -1536,10 +1536,10 @@ namespace Core {
 				if (logger) {
 					MCTSGameState state = MCTS::captureGameState(currentPhase, playerOneTurn);
 					MCTSAction mctsAction;
-					mctsAction.cardNodeIndex = chosenNodeIndex;
-					mctsAction.actionType = action;
-					mctsAction.cardName = cardName;
-					TurnRecord turn = createTurnRecord(state, mctsAction, nrOfRounds, 0.5, 0.5);
+					mctsAction.cardNodeIndex = static_cast<uint8_t>(chosenNodeIndex);
+					mctsAction.actionType = static_cast<uint8_t>(action);
+					mctsAction.cardId = cardCatalogId;
+					TurnRecord turn = createTurnRecord(state, mctsAction, nrOfRounds, searchStats);
 					if (logger.has_value()) {
 						logger->get().logTurn(turn);
 					}
@@ -1988,7 +1988,9 @@ namespace Core {
 			int aiStyle = reader.selectPlaystyle();
 			p2Playstyle = (aiStyle == 1) ? Core::Playstyle::BRITNEY : Core::Playstyle::SPEARS;
 			p1Decisions = std::make_unique<Core::HumanDecisionMaker>();
-			p2Decisions = std::make_unique<Core::MCTSDecisionMaker>(p2Playstyle, 1000, 1.414, 20);
+			auto aiDecisions = std::make_unique<Core::MCTSDecisionMaker>(p2Playstyle, 1000, 1.414, 20);
+			aiDecisions->setPondering(true);
+			p2Decisions = std::move(aiDecisions);
 
 			DisplayRequestEvent infoEvent;
 			infoEvent.displayType = DisplayRequestEvent::Type::MESSAGE;
@@ -2029,13 +2031,22 @@ namespace Core {
 			gameState.GetPlayer1()->m_player = std::make_unique<Models::Player>(1, "AI_P1");
 			gameState.GetPlayer2()->m_player = std::make_unique<Models::Player>(2, "AI_P2");
 
-			p1Decisions = std::make_unique<Core::MCTSDecisionMaker>(p1Playstyle, 1000, 1.414, 20);
-			p2Decisions = std::make_unique<Core::MCTSDecisionMaker>(p2Playstyle, 1000, 1.414, 20);
+			auto p1AI = std::make_unique<Core::MCTSDecisionMaker>(p1Playstyle, 1000, 1.414, 20);
+			auto p2AI = std::make_unique<Core::MCTSDecisionMaker>(p2Playstyle, 1000, 1.414, 20);
+			p1AI->setGameTimeBudget(kTrainingGameTimeBudget);
+			p2AI->setGameTimeBudget(kTrainingGameTimeBudget);
 
 			if (trainingMode) {
 				logger = std::make_unique<TrainingLogger>();
+				WeightsRegistry::setHotReload(true);
+				auto positionCache = std::make_shared<Core::PositionCache>(Core::PositionCacheSettings{});
+				p1AI->setPositionCache(positionCache);
+				p2AI->setPositionCache(positionCache);
 			}
 
+			p1Decisions = std::move(p1AI);
+			p2Decisions = std::move(p2AI);
+
 			DisplayRequestEvent infoEvent;
 			infoEvent.displayType = DisplayRequestEvent::Type::MESSAGE;
 			infoEvent.context = "AI Player 1 is playing as: " + Core::playstyleToString(p1Playstyle);
@@ -1,9 +1,18 @@
 #include <cmath>
 #include <limits>
 module Core.MCTS;
+import <array>;
+import <bit>;
+import <atomic>;
+import <mutex>;
+import <string>;
+import <unordered_map>;
 import <vector>;
 import <memory>;
 import <random>;
+import <thread>;
+import <chrono>;
+import <optional>;
 import <algorithm>;
 import <iostream>;
 import <sstream>;
@@ -12,23 +21,70 @@ import Core.Player;
 import Core.Board;
 import Core.GameState;
 import Core.Node;
+import Core.AgeTree;
 import Core.AIConfig;
+import Core.MCTSArena;
+import Core.TranspositionTable;
+import Core.SearchStats;
+import Core.MCTSPolicies;
+import Core.PositionCache;
 import Models.AgeCard;
 import Models.Wonder;
 import Models.Card;
 import Models.ColorType;
+import Models.LinkingSymbolType;
+import Models.TradeRuleType;
+import Models.Player;
 namespace Core {
 namespace {
+    constexpr int MilitaryCentre = 9;
+    constexpr int militaryLead(int position, bool forPlayer1) {
+        return forPlayer1 ? MilitaryCentre - position : position - MilitaryCentre;
+    }
+    constexpr bool hasMilitaryVictory(int position, bool forPlayer1) {
+        return militaryLead(position, forPlayer1) >= MilitaryCentre;
+    }
+    constexpr double shieldPrior(int shields, int position, bool forPlayer1) {
+        return shields * static_cast<double>(MilitaryCentre + militaryLead(position, forPlayer1)) / MilitaryCentre;
+    }
+    static_assert(hasMilitaryVictory(0, true) && hasMilitaryVictory(18, false));
+    static_assert(shieldPrior(2, 1, true) > shieldPrior(2, 17, true));
+    static_assert(shieldPrior(2, 17, false) > shieldPrior(2, 1, false));
+    size_t tradeRuleSlot(Models::TradeRuleType rule) {
+        switch (rule) {
+            case Models::TradeRuleType::CLAY: return resourceSlot(Models::ResourceType::CLAY);
+            case Models::TradeRuleType::WOOD: return resourceSlot(Models::ResourceType::WOOD);
+            case Models::TradeRuleType::STONE: return resourceSlot(Models::ResourceType::STONE);
+            case Models::TradeRuleType::GLASS: return resourceSlot(Models::ResourceType::GLASS);
+            case Models::TradeRuleType::PAPYRUS: return resourceSlot(Models::ResourceType::PAPYRUS);
+        }
+        return resourceSlot(Models::ResourceType::NO_RESOURCE);
+    }
+    uint8_t fixedPriceMask(const std::unordered_map<Models::TradeRuleType, bool>& rules) {
+        uint8_t mask = 0;
+        for (const auto& [rule, active] : rules) {
+            if (active) mask |= static_cast<uint8_t>(1u << tradeRuleSlot(rule));
+        }
+        return mask;
+    }
     CardInfo extractCardInfo(const Models::Card* card) {
         CardInfo info;
         if (!card) return info;
         info.name = card->getName();
         info.color = card->getColor();
         info.victoryPoints = card->getVictoryPoints();
-        info.resourceCost = card->getResourceCost();
+        info.linkingSymbol = card->getHasLinkingSymbol().value_or(Models::LinkingSymbolType::NO_SYMBOL);
+        info.requiredLinkingSymbol = card->getRequiresLinkingSymbol().value_or(Models::LinkingSymbolType::NO_SYMBOL);
+        info.fixedPriceResources = fixedPriceMask(card->getTradeRules());
+        for (const auto& [resource, quantity] : card->getResourceCost()) {
+            info.resourceCost[resourceSlot(resource)] += quantity;
+        }
         if (const auto* ageCard = dynamic_cast<const Models::AgeCard*>(card)) {
             info.shieldPoints = ageCard->getShieldPoints();
-            info.resourcesProduction = ageCard->getResourcesProduction();
+            info.coinCost = ageCard->getCoinCost();
+            for (const auto& [resource, quantity] : ageCard->getResourcesProduction()) {
+                info.resourcesProduction[resourceSlot(resource)] += quantity;
+            }
             if (ageCard->getScientificSymbols().has_value()) {
                 info.hasScientificSymbol = true;
                 info.scientificSymbol = ageCard->getScientificSymbols().value();
@@ -36,134 +92,911 @@ namespace {
         }
         if (const auto* wonder = dynamic_cast<const Models::Wonder*>(card)) {
             info.shieldPoints = wonder->getShieldPoints();
-            info.isConstructed = wonder->IsConstructed();
             auto resProd = wonder->getResourceProduction();
             if (resProd != Models::ResourceType::NO_RESOURCE) {
-                info.resourcesProduction[resProd] = 1;
+                info.resourcesProduction[resourceSlot(resProd)] = 1;
             }
         }
         return info;
     }
-    PlayerInfo extractPlayerInfo(const std::shared_ptr<Player>& player) {
-        PlayerInfo info;
-        if (!player || !player->m_player) return info;
-        auto& modelPlayer = player->m_player;
-        auto coins = modelPlayer->getRemainingCoins();
-        info.coins = modelPlayer->totalCoins(coins);
-        info.cardCount = static_cast<uint8_t>(modelPlayer->getOwnedCards().size());
-        info.wonderCount = static_cast<uint8_t>(modelPlayer->getOwnedWonders().size());
-        info.tokenCount = static_cast<uint8_t>(modelPlayer->getOwnedTokens().size());
-        for (const auto& card : modelPlayer->getOwnedCards()) {
-            if (card) {
-                CardInfo cardInfo = extractCardInfo(card.get());
-                info.ownedCards.push_back(cardInfo);
-                switch (cardInfo.color) {
-                    case Models::ColorType::BROWN: info.brownCards++; break;
-                    case Models::ColorType::GREY: info.greyCards++; break;
-                    case Models::ColorType::BLUE: info.blueCards++; break;
-                    case Models::ColorType::RED: info.redCards++; break;
-                    case Models::ColorType::GREEN: info.greenCards++; break;
-                    case Models::ColorType::YELLOW: info.yellowCards++; break;
-                    case Models::ColorType::PURPLE: info.purpleCards++; break;
-                    default: break;
-                }
+    struct CardCatalogStorage {
+        std::array<CardInfo, MCTSCardCatalog::MaxCards> cards;
+        std::unordered_map<std::string, uint8_t> idsByName;
+        std::atomic<size_t> size{ 0 };
+        std::mutex mutex;
+    };
+    CardCatalogStorage& catalogStorage() {
+        static CardCatalogStorage storage;
+        return storage;
+    }
+    template <typename Tree>
+    PyramidTopology buildTopology() {
+        std::vector<std::unique_ptr<Models::Card>> placeholders(AgePyramid::MaxSlots);
+        Tree tree(std::move(placeholders));
+        auto nodes = tree.releaseNodes();
+        PyramidTopology topology;
+        topology.slotCount = std::min(nodes.size(), AgePyramid::MaxSlots);
+        auto indexOf = [&](const std::shared_ptr<Node>& node) -> size_t {
+            for (size_t i = 0; i < topology.slotCount; ++i) {
+                if (node && nodes[i] == node) return i;
+            }
+            return AgePyramid::MaxSlots;
+        };
+        for (size_t i = 0; i < topology.slotCount; ++i) {
+            if (!nodes[i]) continue;
+            for (const auto& child : { nodes[i]->getChild1(), nodes[i]->getChild2() }) {
+                size_t c = indexOf(child);
+                if (c >= AgePyramid::MaxSlots) continue;
+                topology.childMask[i] |= 1u << c;
+                topology.parentMask[c] |= 1u << i;
             }
         }
-        for (const auto& wonder : modelPlayer->getOwnedWonders()) {
-            if (wonder) {
-                CardInfo wonderInfo = extractCardInfo(wonder.get());
-                info.ownedWonders.push_back(wonderInfo);
+        return topology;
+    }
+    void refreshAvailability(AgePyramid& pyramid, const PyramidTopology& topology) {
+        pyramid.available = 0;
+        for (uint32_t bits = pyramid.remaining; bits != 0; bits &= bits - 1) {
+            size_t slot = static_cast<size_t>(std::countr_zero(bits));
+            if ((pyramid.remaining & topology.childMask[slot]) == 0) {
+                pyramid.available |= 1u << slot;
             }
         }
-        info.permanentResources = modelPlayer->getOwnedPermanentResources();
-        info.tradingResources = modelPlayer->getOwnedTradingResources();
-        info.scientificSymbols = modelPlayer->getOwnedScientificSymbols();
-        const auto& points = modelPlayer->getPoints();
+    }
+    void takeFromPyramid(AgePyramid& pyramid, const PyramidTopology& topology, size_t slot) {
+        const uint32_t bit = 1u << slot;
+        pyramid.remaining &= ~bit;
+        pyramid.available &= ~bit;
+        for (uint32_t parents = topology.parentMask[slot] & pyramid.remaining; parents != 0; parents &= parents - 1) {
+            size_t parent = static_cast<size_t>(std::countr_zero(parents));
+            if ((pyramid.remaining & topology.childMask[parent]) == 0) {
+                pyramid.available |= 1u << parent;
+            }
+        }
+    }
+    void addPlayerFeatures(FeatureVector& features, const PlayerInfo& player, int sign) {
+        auto add = [&features, sign](EvalFeature feature, int value) {
+            features[static_cast<size_t>(feature)] += static_cast<int16_t>(sign * value);
+        };
+        int resources = 0;
+        for (uint8_t amount : player.permanentResources) resources += amount;
+        add(EvalFeature::COINS, player.coins);
+        add(EvalFeature::CARDS, player.cardCount);
+        add(EvalFeature::BLUE_CARDS, player.blueCards);
+        add(EvalFeature::GREEN_CARDS, player.greenCards);
+        add(EvalFeature::RED_CARDS, player.redCards);
+        add(EvalFeature::YELLOW_CARDS, player.yellowCards);
+        add(EvalFeature::BUILDING_VP, player.buildingVP);
+        add(EvalFeature::WONDER_VP, player.wonderVP);
+        add(EvalFeature::RESOURCES, resources);
+        add(EvalFeature::SCIENCE_TYPES, player.scientificSymbolCount());
+    }
+    void addColorCount(PlayerInfo& player, Models::ColorType color) {
+        switch (color) {
+            case Models::ColorType::BROWN: player.brownCards++; break;
+            case Models::ColorType::GREY: player.greyCards++; break;
+            case Models::ColorType::BLUE: player.blueCards++; break;
+            case Models::ColorType::RED: player.redCards++; break;
+            case Models::ColorType::GREEN: player.greenCards++; break;
+            case Models::ColorType::YELLOW: player.yellowCards++; break;
+            case Models::ColorType::PURPLE: player.purpleCards++; break;
+            default: break;
+        }
+    }
+    void capturePlayer(PlayerInfo& info, Models::Player& player) {
+        info.coins = player.totalCoins(player.getRemainingCoins());
+        info.cardCount = static_cast<uint8_t>(player.getOwnedCards().size());
+        info.tokenCount = static_cast<uint8_t>(player.getOwnedTokens().size());
+        for (const auto& wonder : player.getOwnedWonders()) {
+            if (!wonder || info.wonderCount >= PlayerInfo::MaxWonders) continue;
+            uint8_t id = MCTSCardCatalog::intern(*wonder);
+            if (id == MCTSCardCatalog::NoCard) continue;
+            if (wonder->IsConstructed()) info.constructedWonders |= static_cast<uint8_t>(1u << info.wonderCount);
+            info.wonderIds[info.wonderCount++] = id;
+        }
+        for (const auto& card : player.getOwnedCards()) {
+            if (!card) continue;
+            addColorCount(info, card->getColor());
+            if (card->getColor() == Models::ColorType::BLUE) info.blueVP += card->getVictoryPoints();
+            if (const auto symbol = card->getHasLinkingSymbol(); symbol.has_value() && *symbol != Models::LinkingSymbolType::NO_SYMBOL) {
+                info.addLinkingSymbol(*symbol);
+            }
+            const auto* ageCard = dynamic_cast<const Models::AgeCard*>(card.get());
+            if (ageCard && (card->getColor() == Models::ColorType::BROWN || card->getColor() == Models::ColorType::GREY)) {
+                for (const auto& [resource, quantity] : ageCard->getResourcesProduction()) {
+                    info.brownGreyProduction[resourceSlot(resource)] += quantity;
+                }
+            }
+        }
+        info.fixedPriceResources = fixedPriceMask(player.getTradeRules());
+        for (size_t token = 0; token <= static_cast<size_t>(Models::TokenIndex::URBANISM); ++token) {
+            if (player.hasToken(static_cast<Models::TokenIndex>(token))) info.addProgressToken(token);
+        }
+        for (const auto& [resource, quantity] : player.getOwnedPermanentResources()) {
+            info.permanentResources[resourceSlot(resource)] = quantity;
+        }
+        for (const auto& [resource, quantity] : player.getOwnedTradingResources()) {
+            info.tradingResources[resourceSlot(resource)] = quantity;
+        }
+        for (const auto& [symbol, count] : player.getOwnedScientificSymbols()) {
+            if (count > 0) info.addScientificSymbol(symbol);
+        }
+        const auto& points = player.getPoints();
         info.militaryVP = points.m_militaryVictoryPoints;
         info.buildingVP = points.m_buildingVictoryPoints;
         info.wonderVP = points.m_wonderVictoryPoints;
         info.progressVP = points.m_progressVictoryPoints;
-        return info;
     }
+    struct ZobristKeys {
+        std::array<std::array<std::array<uint64_t, 256>, sizeof(PlayerInfo)>, 2> player{};
+        std::array<std::array<std::array<uint64_t, MCTSCardCatalog::MaxCards + 1>, AgePyramid::MaxSlots>, 3> slots{};
+        std::array<uint64_t, 19> pawn{};
+        std::array<uint64_t, 4> phase{};
+        std::array<uint64_t, 4> winner{};
+        uint64_t sideToMove = 0;
+        uint64_t gameOver = 0;
+    };
+    const ZobristKeys& zobristKeys() {
+        static const std::unique_ptr<ZobristKeys> keys = [] {
+            auto table = std::make_unique<ZobristKeys>();
+            uint64_t seed = 0x9E3779B97F4A7C15ull;
+            auto next = [&seed]() {
+                uint64_t z = (seed += 0x9E3779B97F4A7C15ull);
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+                return z ^ (z >> 31);
+            };
+            for (auto& side : table->player) for (auto& field : side) for (auto& key : field) key = next();
+            for (auto& age : table->slots) for (auto& slot : age) for (auto& key : slot) key = next();
+            for (auto& key : table->pawn) key = next();
+            for (auto& key : table->phase) key = next();
+            for (auto& key : table->winner) key = next();
+            table->sideToMove = next();
+            table->gameOver = next();
+            return table;
+        }();
+        return *keys;
+    }
+    uint64_t hashPlayer(const PlayerInfo& player, size_t side) {
+        const auto& keys = zobristKeys().player[side];
+        const auto* bytes = reinterpret_cast<const unsigned char*>(&player);
+        uint64_t hash = 0;
+        for (size_t i = 0; i < sizeof(PlayerInfo); ++i) hash ^= keys[i][bytes[i]];
+        return hash;
+    }
+    uint64_t hashPlayerDelta(const PlayerInfo& before, const PlayerInfo& after, size_t side) {
+        const auto& keys = zobristKeys().player[side];
+        const auto* oldBytes = reinterpret_cast<const unsigned char*>(&before);
+        const auto* newBytes = reinterpret_cast<const unsigned char*>(&after);
+        uint64_t delta = 0;
+        for (size_t i = 0; i < sizeof(PlayerInfo); ++i) {
+            if (oldBytes[i] != newBytes[i]) delta ^= keys[i][oldBytes[i]] ^ keys[i][newBytes[i]];
+        }
+        return delta;
+    }
+    uint64_t hashGlobals(const MCTSGameState& state) {
+        const auto& keys = zobristKeys();
+        uint64_t hash = keys.pawn[static_cast<size_t>(std::clamp<int>(state.militaryPosition, 0, 18))];
+        hash ^= keys.phase[static_cast<size_t>(std::min<int>(state.currentPhase, 3))];
+        hash ^= keys.winner[static_cast<size_t>(std::clamp<int>(state.winner + 1, 0, 3))];
+        if (state.player1Turn) hash ^= keys.sideToMove;
+        if (state.gameOver) hash ^= keys.gameOver;
+        return hash;
+    }
+    struct RootStatistics {
+        std::vector<int> visits;
+        std::vector<double> values;
+        std::vector<ProvenValue> proven;
+        std::vector<int> votes;
+    };
+    RootStatistics collectRootStatistics(const MCTSNode& root, const ActionList& actions) {
+        RootStatistics stats;
+        stats.visits.assign(actions.size(), 0);
+        stats.values.assign(actions.size(), 0.0);
+        stats.proven.assign(actions.size(), ProvenValue::UNKNOWN);
+        stats.votes.assign(actions.size(), 0);
+        for (const auto& child : root.getChildren()) {
+            auto it = std::find(actions.begin(), actions.end(), child->getAction());
+            if (it == actions.end()) continue;
+            size_t idx = static_cast<size_t>(std::distance(actions.begin(), it));
+            stats.visits[idx] += child->getVisits();
+            stats.values[idx] += child->getValue();
+            stats.proven[idx] = child->getProven();
+        }
+        return stats;
+    }
+    void addGained(RootStatistics& gained, const RootStatistics& after, const RootStatistics& before) {
+        gained.visits.resize(after.visits.size(), 0);
+        gained.values.resize(after.values.size(), 0.0);
+        for (size_t a = 0; a < after.visits.size(); ++a) {
+            if (after.visits[a] <= before.visits[a]) continue;
+            gained.visits[a] += after.visits[a] - before.visits[a];
+            gained.values[a] += after.values[a] - before.values[a];
+        }
+    }
+    struct HalvingProgress {
+        std::vector<std::pair<double, MCTSAction>> ranked;
+        size_t rounds = 0;
+        size_t round = 0;
+        size_t next = 0;
+        int perCandidate = 0;
+        std::optional<std::chrono::steady_clock::duration> timeShare;
+        int spent = 0;
+        std::chrono::steady_clock::duration spentTime{};
+        bool started = false;
+    };
+    struct SearchBudget {
+        std::atomic<int> remaining{ 0 };
+        std::atomic<int> completed{ 0 };
+        std::atomic<bool> stop{ false };
+        std::chrono::steady_clock::time_point start{};
+        std::optional<std::chrono::steady_clock::time_point> deadline;
+        int checkInterval = 64;
+        bool earlyStop = true;
+        size_t nodeLimit = 0;
+        size_t byteLimit = 0;
+        std::atomic<bool> memoryFull{ false };
+        HalvingProgress halving;
+    };
+    void initBudget(SearchBudget& budget, int iterations, std::optional<std::chrono::milliseconds> timeBudget,
+                    int checkInterval, bool earlyStop) {
+        budget.start = std::chrono::steady_clock::now();
+        budget.remaining.store(timeBudget ? std::numeric_limits<int>::max() : iterations, std::memory_order_relaxed);
+        if (timeBudget) budget.deadline = budget.start + *timeBudget;
+        budget.checkInterval = std::max(checkInterval, 1);
+        budget.earlyStop = earlyStop;
+    }
+    void limitMemory(SearchBudget& budget, const MemoryLimit& limit, size_t arenaCount) {
+        budget.nodeLimit = limit.maxNodes / std::max<size_t>(arenaCount, 1);
+        budget.byteLimit = limit.maxBytes / std::max<size_t>(arenaCount, 1);
+    }
+    bool memoryExceeded(const MCTSArena& arena, const SearchBudget& budget) {
+        return (budget.nodeLimit > 0 && arena.getObjectCount() >= budget.nodeLimit) ||
+               (budget.byteLimit > 0 && arena.getAllocatedBytes() >= budget.byteLimit);
+    }
+    int retentionThreshold(const MCTSNode& root, double retainFraction) {
+        std::vector<int> visits;
+        std::vector<const MCTSNode*> pending{ &root };
+        while (!pending.empty()) {
+            const MCTSNode* node = pending.back();
+            pending.pop_back();
+            for (const MCTSNode* child : node->getChildren()) {
+                visits.push_back(child->getVisits());
+                pending.push_back(child);
+            }
+        }
+        const size_t keep = static_cast<size_t>(static_cast<double>(visits.size()) * std::clamp(retainFraction, 0.0, 1.0));
+        if (keep >= visits.size()) return 0;
+        std::nth_element(visits.begin(), visits.begin() + static_cast<std::ptrdiff_t>(keep), visits.end(), std::greater<int>());
+        return visits[keep] + 1;
+    }
+    bool budgetExhausted(const MCTSNode& root, const SearchBudget& budget) {
+        if (root.isProven()) return true;
+        double iterationsLeft = static_cast<double>(budget.remaining.load(std::memory_order_relaxed));
+        if (budget.deadline) {
+            const auto now = std::chrono::steady_clock::now();
+            if (now >= *budget.deadline) return true;
+            const double elapsed = std::chrono::duration<double>(now - budget.start).count();
+            const double left = std::chrono::duration<double>(*budget.deadline - now).count();
+            if (elapsed <= 0.0) return false;
+            iterationsLeft = budget.completed.load(std::memory_order_relaxed) * left / elapsed;
+        }
+        if (!budget.earlyStop) return false;
+        int best = 0;
+        int second = 0;
+        for (const MCTSNode* child : root.getChildren()) {
+            const int visits = child->getVisits();
+            if (visits > best) {
+                second = best;
+                best = visits;
+            } else if (visits > second) {
+                second = visits;
+            }
+        }
+        return best - second > iterationsLeft;
+    }
+    struct TreePolicy;
+    using IterateFn = void (*)(MCTSNode& root, SearchBudget& budget, double explorationConstant, int maxDepth, int virtualLoss,
+                               TranspositionTable* table, const TreePolicy& policy, std::mt19937& rng, MCTSArena& arena,
+                               SearchStats& stats);
+    struct TreePolicy {
+        const ProgressiveWidening* widening = nullptr;
+        const PlayoutSettings* playout = nullptr;
+        const RaveSettings* rave = nullptr;
+        FeatureWeights learned{};
+        IterateFn iterate = nullptr;
+        RootPolicy root = RootPolicy::TREE;
+        size_t rootCandidates = SearchPolicy::DefaultRootCandidates;
+    };
+    template<typename Selection, typename Playout, typename Evaluator>
+    void runIterations(MCTSNode& root, SearchBudget& budget, double explorationConstant, int maxDepth, int virtualLoss,
+                       TranspositionTable* table, const TreePolicy& policy, std::mt19937& rng, MCTSArena& arena,
+                       SearchStats& stats) {
+        const Playout playout(*policy.playout);
+        const Evaluator evaluator(policy.learned);
+        using Clock = std::chrono::steady_clock;
+        auto elapsedMs = [](Clock::time_point from, Clock::time_point to) {
+            return std::chrono::duration<double, std::milli>(to - from).count();
+        };
+        AmafTrace trace;
+        AmafTrace* amaf = policy.rave && policy.rave->enabled ? &trace : nullptr;
+        int sinceCheck = 0;
+        while (!budget.stop.load(std::memory_order_relaxed) && budget.remaining.fetch_sub(1, std::memory_order_relaxed) > 0) {
+            const bool timed = stats.iterations % SearchStats::PhaseSampleInterval == 0;
+            const Clock::time_point selectStart = timed ? Clock::now() : Clock::time_point{};
+            MCTSNode* node = root.descend<Selection>(explorationConstant, virtualLoss, table, policy.widening, policy.rave);
+            const Clock::time_point expandStart = timed ? Clock::now() : Clock::time_point{};
+            if (!node->getState().isTerminal() && !node->isProven() && node->canExpand(policy.widening)) {
+                node = node->expand(arena, virtualLoss, policy.widening);
+            }
+            const Clock::time_point simulateStart = timed ? Clock::now() : Clock::time_point{};
+            if (amaf) amaf->clear();
+            int rolloutLength = 0;
+            double reward = node->rollout(rng, maxDepth, playout, evaluator, amaf, &rolloutLength);
+            const Clock::time_point backpropagateStart = timed ? Clock::now() : Clock::time_point{};
+            node->backpropagate(reward, virtualLoss, table, amaf);
+            if (timed) {
+                const Clock::time_point end = Clock::now();
+                ++stats.timedIterations;
+                stats.selectMs += elapsedMs(selectStart, expandStart);
+                stats.expandMs += elapsedMs(expandStart, simulateStart);
+                stats.simulateMs += elapsedMs(simulateStart, backpropagateStart);
+                stats.backpropagateMs += elapsedMs(backpropagateStart, end);
+            }
+            int treeDepth = 0;
+            for (const MCTSNode* ancestor = node->getParent(); ancestor != nullptr; ancestor = ancestor->getParent()) ++treeDepth;
+            stats.recordIteration(treeDepth, rolloutLength);
+            budget.completed.fetch_add(1, std::memory_order_relaxed);
+            if (++sinceCheck >= budget.checkInterval) {
+                sinceCheck = 0;
+                if (budgetExhausted(root, budget)) {
+                    budget.stop.store(true, std::memory_order_relaxed);
+                } else if (memoryExceeded(arena, budget)) {
+                    budget.memoryFull.store(true, std::memory_order_relaxed);
+                    budget.stop.store(true, std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+    template<typename Selection, typename Playout>
+    IterateFn iterateFor(EvaluatorKind evaluator, Playstyle playstyle) {
+        if (evaluator == EvaluatorKind::LEARNED) return &runIterations<Selection, Playout, LearnedEvaluator>;
+        if (playstyle == Playstyle::SPEARS) return &runIterations<Selection, Playout, WeightedEvaluator<Playstyle::SPEARS>>;
+        return &runIterations<Selection, Playout, WeightedEvaluator<Playstyle::BRITNEY>>;
+    }
+    template<typename Selection>
+    IterateFn iterateFor(PlayoutPolicy playout, EvaluatorKind evaluator, Playstyle playstyle) {
+        if (playout == PlayoutPolicy::RANDOM) return iterateFor<Selection, RandomPlayout>(evaluator, playstyle);
+        return iterateFor<Selection, GuidedPlayout>(evaluator, playstyle);
+    }
+    IterateFn iterateFor(const SearchPolicy& search, PlayoutPolicy playout, EvaluatorKind evaluator, Playstyle playstyle) {
+        switch (search.selection) {
+            case SelectionRule::UCB1_TUNED: return iterateFor<UCB1Tuned>(playout, evaluator, playstyle);
+            case SelectionRule::PUCT: return iterateFor<PUCT>(playout, evaluator, playstyle);
+            default: return iterateFor<UCB1>(playout, evaluator, playstyle);
+        }
+    }
+    TreePolicy makeTreePolicy(const SearchPolicy& search, const ProgressiveWidening& widening, const PlayoutSettings& playout,
+                              const RaveSettings& rave, Playstyle playstyle) {
+        TreePolicy policy{ &widening, &playout, &rave };
+        policy.learned = toFeatureWeights(WeightsRegistry::current(playstyle).weights);
+        EvaluatorKind evaluator = search.evaluator;
+        if (evaluator == EvaluatorKind::AUTO) {
+            const FeatureWeights& defaults = playstyle == Playstyle::SPEARS ? PlaystyleWeights<Playstyle::SPEARS>::coefficients
+                                                                            : PlaystyleWeights<Playstyle::BRITNEY>::coefficients;
+            evaluator = policy.learned == defaults ? EvaluatorKind::WEIGHTED : EvaluatorKind::LEARNED;
+        }
+        policy.iterate = iterateFor(search, playout.policy, evaluator, playstyle);
+        policy.root = search.root;
+        policy.rootCandidates = std::max<size_t>(search.rootCandidates, 1);
+        return policy;
+    }
+    RootStatistics runSequentialHalving(MCTSNode& root, const ActionList& rootActions, SearchBudget& budget,
+                                        double explorationConstant, int maxDepth, TranspositionTable* table,
+                                        const TreePolicy& policy, std::mt19937& rng, MCTSArena& arena, SearchStats& stats) {
+        while (!root.getState().isTerminal() && !root.isFullyExpanded()) root.expand(arena);
+        const auto children = root.getChildren();
+        const ChildStatistics& childStats = root.getChildStatistics();
+        HalvingProgress& progress = budget.halving;
+        if (!progress.started) {
+            for (const MCTSNode* child : children) progress.ranked.emplace_back(SequentialHalving::gumbel(rng), child->getAction());
+        }
+        std::vector<std::pair<double, size_t>> ranked;
+        for (const auto& [noise, action] : progress.ranked) {
+            auto child = std::find_if(children.begin(), children.end(), [&action](const MCTSNode* c) { return c->getAction() == action; });
+            if (child != children.end()) ranked.emplace_back(noise, static_cast<size_t>(std::distance(children.begin(), child)));
+        }
+        auto meanOf = [&](size_t child) {
+            const int visits = children[child]->getVisits();
+            return visits > 0 ? children[child]->getValue() / visits : 0.0;
+        };
+        auto rank = [&]() {
+            int maxVisits = 0;
+            double low = std::numeric_limits<double>::infinity();
+            double high = -std::numeric_limits<double>::infinity();
+            for (const auto& [noise, child] : ranked) {
+                maxVisits = std::max(maxVisits, children[child]->getVisits());
+                if (children[child]->getVisits() == 0) continue;
+                low = std::min(low, meanOf(child));
+                high = std::max(high, meanOf(child));
+            }
+            std::vector<double> scores(children.size(), 0.0);
+            for (const auto& [noise, child] : ranked) {
+                const double normalized = high > low ? (meanOf(child) - low) / (high - low) : 0.0;
+                const double value = children[child]->getVisits() > 0 ? normalized : 0.0;
+                scores[child] = SequentialHalving::score(noise, childStats.priors[child], value, maxVisits);
+            }
+            std::stable_sort(ranked.begin(), ranked.end(), [&scores](const auto& a, const auto& b) {
+                return scores[a.second] > scores[b.second];
+            });
+        };
+        auto remember = [&]() {
+            progress.ranked.clear();
+            for (const auto& [noise, child] : ranked) progress.ranked.emplace_back(noise, children[child]->getAction());
+        };
+        if (ranked.empty()) return collectRootStatistics(root, rootActions);
+        if (!progress.started) {
+            rank();
+            ranked.resize(std::min(ranked.size(), policy.rootCandidates));
+            remember();
+            progress.rounds = SequentialHalving::rounds(ranked.size());
+            progress.started = true;
+        }
+        for (; progress.round < progress.rounds && ranked.size() > 1 && !root.isProven(); ++progress.round) {
+            if (progress.perCandidate == 0) {
+                const size_t roundsLeft = progress.rounds - progress.round;
+                const int iterationsLeft = std::max(budget.remaining.load(std::memory_order_relaxed), 0);
+                progress.perCandidate = std::max(iterationsLeft / static_cast<int>(roundsLeft * ranked.size()), 1);
+                progress.timeShare.reset();
+                if (budget.deadline) {
+                    const auto now = std::chrono::steady_clock::now();
+                    if (now >= *budget.deadline) break;
+                    progress.timeShare = (*budget.deadline - now) / static_cast<int>(roundsLeft * ranked.size());
+                }
+            }
+            for (; progress.next < ranked.size(); ++progress.next) {
+                SearchBudget share;
+                share.start = std::chrono::steady_clock::now();
+                share.remaining.store(progress.timeShare ? std::numeric_limits<int>::max() : progress.perCandidate - progress.spent,
+                                      std::memory_order_relaxed);
+                if (progress.timeShare) share.deadline = share.start + (*progress.timeShare - progress.spentTime);
+                share.checkInterval = budget.checkInterval;
+                share.earlyStop = false;
+                share.nodeLimit = budget.nodeLimit;
+                share.byteLimit = budget.byteLimit;
+                policy.iterate(*children[ranked[progress.next].second], share, explorationConstant, maxDepth, 0, table, policy, rng, arena, stats);
+                const int completed = share.completed.load(std::memory_order_relaxed);
+                budget.completed.fetch_add(completed, std::memory_order_relaxed);
+                budget.remaining.fetch_sub(completed, std::memory_order_relaxed);
+                if (share.memoryFull.load(std::memory_order_relaxed)) {
+                    progress.spent += completed;
+                    progress.spentTime += std::chrono::steady_clock::now() - share.start;
+                    budget.memoryFull.store(true, std::memory_order_relaxed);
+                    budget.stop.store(true, std::memory_order_relaxed);
+                    return collectRootStatistics(root, rootActions);
+                }
+                progress.spent = 0;
+                progress.spentTime = {};
+            }
+            progress.next = 0;
+            progress.perCandidate = 0;
+            rank();
+            ranked.resize((ranked.size() + 1) / 2);
+            remember();
+        }
+        RootStatistics result = collectRootStatistics(root, rootActions);
+        auto chosen = std::find(rootActions.begin(), rootActions.end(), children[ranked.front().second]->getAction());
+        if (chosen != rootActions.end()) ++result.votes[static_cast<size_t>(std::distance(rootActions.begin(), chosen))];
+        return result;
+    }
+    RootStatistics searchTree(MCTSNode& root, const ActionList& rootActions, SearchBudget& budget, double explorationConstant,
+                              int maxDepth, TranspositionTable* table, const TreePolicy& policy, uint32_t seed,
+                              MCTSArena& arena, SearchStats& stats) {
+        std::mt19937 rng(seed);
+        if (policy.root == RootPolicy::SEQUENTIAL_HALVING) {
+            return runSequentialHalving(root, rootActions, budget, explorationConstant, maxDepth, table, policy, rng, arena, stats);
+        }
+        policy.iterate(root, budget, explorationConstant, maxDepth, 0, table, policy, rng, arena, stats);
+        return collectRootStatistics(root, rootActions);
+    }
+    RootStatistics searchSharedTree(MCTSNode& root, const ActionList& rootActions, SearchBudget& budget, double explorationConstant,
+                                    int maxDepth, int virtualLoss, TranspositionTable* table,
+                                    const TreePolicy& policy, const std::vector<uint32_t>& seeds,
+                                    std::vector<std::unique_ptr<MCTSArena>>& arenas, std::vector<SearchStats>& stats) {
+        {
+            std::vector<std::jthread> workers;
+            workers.reserve(seeds.size());
+            for (size_t t = 0; t < seeds.size(); ++t) {
+                workers.emplace_back([&, t]() {
+                    std::mt19937 rng(seeds[t]);
+                    policy.iterate(root, budget, explorationConstant, maxDepth, virtualLoss, table, policy, rng, *arenas[t], stats[t]);
+                });
+            }
+        }
+        return collectRootStatistics(root, rootActions);
+    }
+    bool matchesObservedPosition(const MCTSGameState& predicted, const MCTSGameState& observed) {
+        if (predicted.currentPhase != observed.currentPhase || predicted.player1Turn != observed.player1Turn) return false;
+        for (size_t age = 0; age < predicted.pyramids.size(); ++age) {
+            const AgePyramid& expected = predicted.pyramids[age];
+            const AgePyramid& actual = observed.pyramids[age];
+            if (expected.remaining != actual.remaining) return false;
+            for (uint32_t revealed = actual.remaining & ~actual.hidden; revealed != 0; revealed &= revealed - 1) {
+                const size_t slot = static_cast<size_t>(std::countr_zero(revealed));
+                if (expected.cardIds[slot] != actual.cardIds[slot]) return false;
+            }
+        }
+        auto sameHoldings = [](const PlayerInfo& a, const PlayerInfo& b) {
+            return a.cardCount == b.cardCount && a.wonderCount == b.wonderCount &&
+                   a.constructedWonders == b.constructedWonders;
+        };
+        return sameHoldings(predicted.player1, observed.player1) && sameHoldings(predicted.player2, observed.player2);
+    }
+    size_t unseenPool(size_t age, uint8_t cardId) {
+        if (age == 2 && MCTSCardCatalog::get(cardId).color == Models::ColorType::PURPLE) return UnseenCards::GuildPool;
+        return age;
+    }
+    void seedFromCache(MCTSNode& root, const CachedRoot& cached, double scale, MCTSArena& arena, const ProgressiveWidening& widening) {
+        std::array<bool, CachedRoot::MaxActions> seeded{};
+        bool progress = !root.getState().isTerminal();
+        while (progress) {
+            progress = false;
+            while (root.canExpand(&widening)) root.expand(arena, 0, &widening);
+            for (size_t i = 0; i < cached.actionCount && i < CachedRoot::MaxActions; ++i) {
+                if (seeded[i]) continue;
+                const CachedAction& entry = cached.actions[i];
+                MCTSAction action;
+                action.cardNodeIndex = entry.cardNodeIndex;
+                action.actionType = entry.actionType;
+                action.wonderIndex = entry.wonderIndex;
+                seeded[i] = root.seed(action, static_cast<int>(entry.visits * scale), entry.value);
+                progress = progress || seeded[i];
+            }
+        }
+    }
+    CachedRoot summarizeRoot(const ActionList& actions, const std::vector<int>& visits, const std::vector<double>& values) {
+        std::vector<size_t> order;
+        for (size_t a = 0; a < actions.size(); ++a) {
+            if (visits[a] > 0) order.push_back(a);
+        }
+        std::stable_sort(order.begin(), order.end(), [&visits](size_t a, size_t b) { return visits[a] > visits[b]; });
+        CachedRoot root;
+        double totalValue = 0.0;
+        root.actionCount = static_cast<uint8_t>(std::min(order.size(), CachedRoot::MaxActions));
+        for (size_t i = 0; i < root.actionCount; ++i) {
+            const size_t a = order[i];
+            CachedAction& entry = root.actions[i];
+            entry.cardNodeIndex = actions[a].cardNodeIndex;
+            entry.actionType = actions[a].actionType;
+            entry.wonderIndex = actions[a].wonderIndex;
+            entry.visits = static_cast<uint32_t>(visits[a]);
+            entry.value = static_cast<float>(values[a] / visits[a]);
+            root.visits += entry.visits;
+            totalValue += values[a];
+        }
+        if (root.visits > 0) root.value = static_cast<float>(totalValue / root.visits);
+        return root;
+    }
+    uint64_t mixHash(uint64_t hash, uint64_t value) {
+        uint64_t z = hash ^ (value + 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+    uint64_t positionCacheKey(uint64_t position, Playstyle playstyle, const FeatureWeights& weights) {
+        uint64_t key = mixHash(position, static_cast<uint64_t>(playstyle));
+        for (double weight : weights) key = mixHash(key, std::bit_cast<uint64_t>(weight));
+        return key != 0 ? key : 1;
+    }
+    uint64_t cardNameHash(uint8_t id) {
+        if (id == MCTSCardCatalog::NoCard) return 0;
+        uint64_t hash = 0xCBF29CE484222325ull;
+        for (unsigned char c : MCTSCardCatalog::get(id).name) hash = (hash ^ c) * 0x100000001B3ull;
+        return hash;
+    }
+    int resolveThreadCount(int requested) {
+        if (requested > 0) return requested;
+        unsigned int hardware = std::thread::hardware_concurrency();
+        return hardware > 0 ? static_cast<int>(hardware) : 1;
+    }
+    size_t argmaxScore(const double* scores, size_t count) {
+        size_t best = 0;
+        double bestScore = -std::numeric_limits<double>::infinity();
+        for (size_t i = 0; i < count; ++i) {
+            if (scores[i] > bestScore) {
+                bestScore = scores[i];
+                best = i;
+            }
+        }
+        return best;
+    }
+}
+uint8_t MCTSCardCatalog::intern(const Models::Card& card) {
+    auto& storage = catalogStorage();
+    std::lock_guard<std::mutex> lock(storage.mutex);
+    auto it = storage.idsByName.find(card.getName());
+    if (it != storage.idsByName.end()) return it->second;
+    size_t id = storage.size.load(std::memory_order_relaxed);
+    if (id >= MaxCards) return NoCard;
+    storage.cards[id] = extractCardInfo(&card);
+    storage.idsByName.emplace(card.getName(), static_cast<uint8_t>(id));
+    storage.size.store(id + 1, std::memory_order_release);
+    return static_cast<uint8_t>(id);
+}
+const CardInfo& MCTSCardCatalog::get(uint8_t id) {
+    static const CardInfo empty{};
+    auto& storage = catalogStorage();
+    if (id >= storage.size.load(std::memory_order_acquire)) return empty;
+    return storage.cards[id];
 }
-MCTSNode::MCTSNode(const MCTSGameState& state, MCTSNode* parent, const MCTSAction& action)
-    : m_state(state)
+const PyramidTopology& MCTS::getPyramidTopology(int age) {
+    static const std::array<PyramidTopology, 3> topologies = {
+        buildTopology<Age1Tree>(),
+        buildTopology<Age2Tree>(),
+        buildTopology<Age3Tree>()
+    };
+    static const PyramidTopology empty{};
+    if (age < 1 || age > 3) return empty;
+    return topologies[age - 1];
+}
+MCTSNode::MCTSNode(MCTSGameState state, MCTSNode* parent, const MCTSAction& action)
+    : m_state(std::move(state))
     , m_action(action)
     , m_parent(parent)
     , m_visits(0)
     , m_totalValue(0.0)
     , m_untriedActionsIndex(0)
 {
+    if (m_state.availableActions.empty() && !m_state.isTerminal()) {
+        m_state.availableActions = MCTS::getLegalActions(m_state, m_state.currentPhase);
+    }
 }
-double MCTSNode::getUCB1Score(double explorationConstant) const {
-    if (m_visits == 0) {
+double RaveSettings::beta(int visits) const {
+    if (!enabled) return 0.0;
+    return std::sqrt(equivalence / (3.0 * visits + equivalence));
+}
+double MCTSNode::getUCB1Score(double explorationConstant, const TranspositionTable* table, const RaveSettings* rave) const {
+    const int visits = m_visits.load(std::memory_order_relaxed) + m_virtualLoss.load(std::memory_order_relaxed);
+    if (visits == 0) {
         return std::numeric_limits<double>::infinity();
     }
-    double exploitation = m_totalValue / static_cast<double>(m_visits);
+    double exploitation = m_totalValue.load(std::memory_order_relaxed) / static_cast<double>(visits);
+    TranspositionStats shared;
+    if (table && table->probe(m_state.hash, shared) && shared.visits > static_cast<uint32_t>(visits)) {
+        exploitation = shared.totalValue / static_cast<double>(shared.visits);
+    }
+    const int amafVisits = m_amafVisits.load(std::memory_order_relaxed);
+    if (rave && amafVisits > 0) {
+        const double beta = rave->beta(visits);
+        exploitation = (1.0 - beta) * exploitation + beta * m_amafValue.load(std::memory_order_relaxed) / amafVisits;
+    }
     double exploration = 0.0;
-    if (m_parent && m_parent->m_visits > 0) {
+    const int parentVisits = m_parent
+        ? m_parent->m_visits.load(std::memory_order_relaxed) + m_parent->m_virtualLoss.load(std::memory_order_relaxed)
+        : 0;
+    if (parentVisits > 0) {
         exploration = explorationConstant * std::sqrt(
-            std::log(static_cast<double>(m_parent->m_visits)) / 
-            static_cast<double>(m_visits)
+            std::log(static_cast<double>(parentVisits)) / 
+            static_cast<double>(visits)
         );
     }
     return exploitation + exploration;
 }
 bool MCTSNode::isFullyExpanded() const {
-    return m_untriedActionsIndex >= m_state.availableActions.size();
+    return m_childCount.load(std::memory_order_acquire) >= m_state.availableActions.size();
+}
+bool MCTSNode::canExpand(const ProgressiveWidening* widening) const {
+    const size_t actionCount = m_state.availableActions.size();
+    const size_t limit = widening ? widening->childLimit(getVisits(), actionCount) : actionCount;
+    const size_t childCount = m_childCount.load(std::memory_order_acquire);
+    if (childCount < limit) return true;
+    return childCount < actionCount && m_provenLosses.load(std::memory_order_acquire) == childCount;
 }
-MCTSNode* MCTSNode::select(double explorationConstant) {
+size_t ProgressiveWidening::childLimit(int visits, size_t actionCount) const {
+    if (!enabled) return actionCount;
+    const double width = std::ceil(constant * std::pow(static_cast<double>(std::max(visits, 1)), exponent));
+    return std::min(actionCount, std::max<size_t>(1, static_cast<size_t>(width)));
+}
+template<typename Selection>
+MCTSNode* MCTSNode::descend(double explorationConstant, int virtualLoss, const TranspositionTable* table,
+                            const ProgressiveWidening* widening, const RaveSettings* rave) {
     MCTSNode* current = this;
-    while (!current->m_state.isTerminal() && current->isFullyExpanded() && !current->isLeaf()) {
-        MCTSNode* best = nullptr;
-        double bestScore = -std::numeric_limits<double>::infinity();
-        for (const auto& child : current->m_children) {
-            double score = child->getUCB1Score(explorationConstant);
-            if (score > bestScore) {
-                bestScore = score;
-                best = child.get();
+    if (virtualLoss != 0) current->m_virtualLoss.fetch_add(virtualLoss, std::memory_order_relaxed);
+    std::array<double, ActionList::MaxActions> scores{};
+    while (!current->m_state.isTerminal() && !current->isProven() && !current->canExpand(widening) && !current->isLeaf()) {
+        const size_t childCount = current->m_childCount.load(std::memory_order_acquire);
+        const ChildStatistics& stats = current->m_childStats;
+        const int parentVisits = current->m_visits.load(std::memory_order_relaxed) +
+                                 current->m_virtualLoss.load(std::memory_order_relaxed);
+        Selection::score(stats, childCount, explorationConstant, parentVisits, scores.data());
+        if (table || (rave && rave->enabled)) {
+            for (size_t i = 0; i < childCount; ++i) {
+                const int visits = std::atomic_ref<int32_t>(stats.visits[i]).load(std::memory_order_relaxed) +
+                                   std::atomic_ref<int32_t>(stats.pending[i]).load(std::memory_order_relaxed);
+                if (visits <= 0) continue;
+                const double mean = std::atomic_ref<double>(stats.values[i]).load(std::memory_order_relaxed) / visits;
+                double exploitation = mean;
+                TranspositionStats shared;
+                if (table && table->probe(stats.hashes[i], shared) && shared.visits > static_cast<uint32_t>(visits)) {
+                    exploitation = shared.totalValue / static_cast<double>(shared.visits);
+                }
+                const MCTSNode* child = current->m_children[i];
+                const int amafVisits = child->m_amafVisits.load(std::memory_order_relaxed);
+                if (rave && amafVisits > 0) {
+                    const double beta = rave->beta(visits);
+                    exploitation = (1.0 - beta) * exploitation + beta * child->m_amafValue.load(std::memory_order_relaxed) / amafVisits;
+                }
+                scores[i] += exploitation - mean;
             }
         }
-        if (best) {
-            current = best;
-        } else {
-            break;
+        if (current->m_provenLosses.load(std::memory_order_relaxed) > 0) {
+            for (size_t i = 0; i < childCount; ++i) {
+                if (std::atomic_ref<ProvenValue>(stats.proven[i]).load(std::memory_order_relaxed) == ProvenValue::LOSS) {
+                    scores[i] = -std::numeric_limits<double>::infinity();
+                }
+            }
         }
+        MCTSNode* best = current->m_children[argmaxScore(scores.data(), childCount)];
+        if (virtualLoss != 0) {
+            std::atomic_ref<int32_t>(stats.pending[best->m_slot]).fetch_add(virtualLoss, std::memory_order_relaxed);
+            best->m_virtualLoss.fetch_add(virtualLoss, std::memory_order_relaxed);
+        }
+        current = best;
     }
     return current;
 }
-MCTSNode* MCTSNode::expand() {
-    if (m_state.isTerminal() || m_untriedActionsIndex >= m_state.availableActions.size()) {
+MCTSNode* MCTSNode::expand(MCTSArena& arena, int virtualLoss, const ProgressiveWidening* widening) {
+    if (m_state.isTerminal()) {
+        return this;
+    }
+    while (m_expansionLock.test_and_set(std::memory_order_acquire)) {
+        m_expansionLock.wait(true, std::memory_order_relaxed);
+    }
+    if (m_untriedActionsIndex >= m_state.availableActions.size()) {
+        m_expansionLock.clear(std::memory_order_release);
+        m_expansionLock.notify_one();
         return this;
     }
-    const MCTSAction& action = m_state.availableActions[m_untriedActionsIndex++];
+    if (m_children == nullptr) {
+        m_children = arena.allocateArray<MCTSNode*>(m_state.availableActions.size());
+        m_childStats.allocate(arena, m_state.availableActions.size());
+        const size_t actionCount = m_state.availableActions.size();
+        std::array<double, ActionList::MaxActions> priors{};
+        double maxPrior = -std::numeric_limits<double>::infinity();
+        for (size_t i = 0; i < actionCount; ++i) {
+            priors[i] = MCTS::actionPrior(m_state, m_state.availableActions[i]);
+            maxPrior = std::max(maxPrior, priors[i]);
+        }
+        std::array<uint8_t, ActionList::MaxActions> order{};
+        for (size_t i = 0; i < order.size(); ++i) order[i] = static_cast<uint8_t>(i);
+        if (widening && widening->enabled) {
+            const auto count = static_cast<std::ptrdiff_t>(actionCount);
+            std::stable_sort(order.begin(), order.begin() + count, [&priors](uint8_t a, uint8_t b) { return priors[a] > priors[b]; });
+        }
+        double total = 0.0;
+        for (size_t i = 0; i < actionCount; ++i) {
+            m_childStats.order[i] = order[i];
+            m_childStats.priors[i] = std::exp(priors[order[i]] - maxPrior);
+            total += m_childStats.priors[i];
+        }
+        for (size_t i = 0; i < actionCount; ++i) m_childStats.priors[i] /= total;
+    }
+    const MCTSAction& action = m_state.availableActions[m_childStats.order[m_untriedActionsIndex++]];
     MCTSGameState newState = MCTS::cloneState(m_state);
     MCTS::applyAction(newState, action);
-    auto child = std::make_unique<MCTSNode>(newState, this, action);
-    MCTSNode* childPtr = child.get();
-    m_children.push_back(std::move(child));
+    MCTSNode* childPtr = arena.create<MCTSNode>(std::move(newState), this, action);
+    const size_t childCount = m_childCount.load(std::memory_order_relaxed);
+    childPtr->m_slot = static_cast<uint8_t>(childCount);
+    m_childStats.hashes[childCount] = childPtr->m_state.hash;
+    if (virtualLoss != 0) {
+        childPtr->m_virtualLoss.fetch_add(virtualLoss, std::memory_order_relaxed);
+        std::atomic_ref<int32_t>(m_childStats.pending[childCount]).fetch_add(virtualLoss, std::memory_order_relaxed);
+    }
+    m_children[childCount] = childPtr;
+    m_childCount.store(childCount + 1, std::memory_order_release);
+    m_expansionLock.clear(std::memory_order_release);
+    m_expansionLock.notify_one();
     return childPtr;
 }
-double MCTSNode::simulate(std::mt19937& rng, int maxDepth) {
+MCTSNode* MCTSNode::cloneSubtree(const MCTSNode& source, MCTSNode* parent, MCTSArena& arena,
+                                 const MCTSGameState* rootState, int minVisits) {
+    MCTSGameState state = source.m_state;
+    if (rootState) {
+        state = *rootState;
+        state.availableActions = source.m_state.availableActions;
+    }
+    MCTSNode* copy = arena.create<MCTSNode>(std::move(state), parent, source.m_action);
+    copy->m_visits.store(source.getVisits(), std::memory_order_relaxed);
+    copy->m_totalValue.store(source.getValue(), std::memory_order_relaxed);
+    copy->m_amafVisits.store(source.getAmafVisits(), std::memory_order_relaxed);
+    copy->m_amafValue.store(source.getAmafValue(), std::memory_order_relaxed);
+    copy->m_proven.store(source.getProven(), std::memory_order_relaxed);
+    const auto children = source.getChildren();
+    std::array<uint8_t, ActionList::MaxActions> order{};
+    size_t kept = 0;
+    for (size_t i = 0; i < children.size(); ++i) {
+        if (children[i]->getVisits() >= minVisits) order[kept++] = static_cast<uint8_t>(i);
+    }
+    if (kept > 0) {
+        const size_t actionCount = copy->m_state.availableActions.size();
+        size_t next = kept;
+        for (size_t i = 0; i < children.size(); ++i) {
+            if (children[i]->getVisits() < minVisits) order[next++] = static_cast<uint8_t>(i);
+        }
+        for (size_t i = children.size(); i < actionCount; ++i) order[next++] = static_cast<uint8_t>(i);
+        copy->m_children = arena.allocateArray<MCTSNode*>(actionCount);
+        copy->m_childStats.allocate(arena, actionCount);
+        for (size_t i = 0; i < actionCount; ++i) {
+            copy->m_childStats.order[i] = source.m_childStats.order[order[i]];
+            copy->m_childStats.priors[i] = source.m_childStats.priors[order[i]];
+        }
+        size_t provenLosses = 0;
+        for (size_t i = 0; i < kept; ++i) {
+            MCTSNode* child = cloneSubtree(*children[order[i]], copy, arena, nullptr, minVisits);
+            child->m_slot = static_cast<uint8_t>(i);
+            copy->m_childStats.visits[i] = child->getVisits();
+            copy->m_childStats.values[i] = child->getValue();
+            copy->m_childStats.squares[i] = source.m_childStats.squares[order[i]];
+            copy->m_childStats.hashes[i] = child->m_state.hash;
+            copy->m_childStats.proven[i] = child->getProven();
+            if (child->getProven() == ProvenValue::LOSS) ++provenLosses;
+            copy->m_children[i] = child;
+        }
+        copy->m_untriedActionsIndex = kept;
+        copy->m_provenLosses.store(provenLosses, std::memory_order_relaxed);
+        copy->m_childCount.store(kept, std::memory_order_release);
+    }
+    return copy;
+}
+size_t PlayoutSettings::choose(const MCTSGameState& state, std::mt19937& rng) const {
+    const ActionList& actions = state.availableActions;
+    std::uniform_int_distribution<size_t> uniform(0, actions.size() - 1);
+    if (policy == PlayoutPolicy::RANDOM || actions.size() == 1) return uniform(rng);
+    std::array<double, ActionList::MaxActions> scores{};
+    size_t best = 0;
+    for (size_t i = 0; i < actions.size(); ++i) {
+        scores[i] = MCTS::actionPrior(state, actions[i]);
+        if (scores[i] > scores[best]) best = i;
+    }
+    if (policy == PlayoutPolicy::EPSILON_GREEDY) {
+        return std::uniform_real_distribution<double>(0.0, 1.0)(rng) < epsilon ? uniform(rng) : best;
+    }
+    double total = 0.0;
+    for (size_t i = 0; i < actions.size(); ++i) {
+        scores[i] = std::exp((scores[i] - scores[best]) / temperature);
+        total += scores[i];
+    }
+    double pick = std::uniform_real_distribution<double>(0.0, total)(rng);
+    for (size_t i = 0; i < actions.size(); ++i) {
+        pick -= scores[i];
+        if (pick <= 0.0) return i;
+    }
+    return best;
+}
+template<typename Playout, typename Evaluator>
+double MCTSNode::rollout(std::mt19937& rng, int maxDepth, const Playout& playout, const Evaluator& evaluator,
+                         AmafTrace* trace, int* rolloutLength) {
+    if (const ProvenValue proven = getProven(); proven != ProvenValue::UNKNOWN && !m_state.isTerminal()) {
+        if (rolloutLength) *rolloutLength = 0;
+        return proven == ProvenValue::WIN ? 1.0 : 0.0;
+    }
     MCTSGameState simState = MCTS::cloneState(m_state);
     int depth = 0;
     while (!MCTS::isTerminal(simState) && depth < maxDepth) {
-        std::vector<MCTSAction> possibleActions = simState.availableActions;
-        if (possibleActions.empty()) {
-            possibleActions = MCTS::getLegalActions(simState, simState.currentPhase);
+        if (simState.availableActions.empty()) {
+            simState.availableActions = MCTS::getLegalActions(simState, simState.currentPhase);
         }
+        const ActionList& possibleActions = simState.availableActions;
         if (possibleActions.empty()) break;
-        std::uniform_int_distribution<size_t> dist(0, possibleActions.size() - 1);
-        const MCTSAction& randomAction = possibleActions[dist(rng)];
-        MCTS::applyAction(simState, randomAction);
+        const MCTSAction playoutAction = possibleActions[playout.choose(simState, rng)];
+        if (trace) trace->record(simState.player1Turn, playoutAction);
+        MCTS::applyAction(simState, playoutAction);
         depth++;
     }
+    if (rolloutLength) *rolloutLength = depth;
     double score = 0.0;
-    AIConfig config(Playstyle::BRITNEY);
-    auto weights = config.getWeights();
     if (MCTS::isTerminal(simState)) {
         int winner = MCTS::getWinner(simState);
-        if (m_state.player1Turn) {
+        if (!m_state.player1Turn) {
             if (winner == 0) score = 1.0;
             else if (winner == 1) score = 0.0;
             else score = 0.5;
@@ -173,38 +1006,73 @@ double MCTSNode::simulate(std::mt19937& rng, int maxDepth) {
             else score = 0.5;
         }
     } else {
-        double p1Score = simState.player1.coins * weights.coinValue +
-                         simState.player1.cardCount * weights.economyPriority +
-                         simState.player1.blueCards * weights.victoryPointValue +
-                         simState.player1.greenCards * weights.sciencePriority +
-                         simState.player1.redCards * weights.militaryPriority;
-        double p2Score = simState.player2.coins * weights.coinValue +
-                         simState.player2.cardCount * weights.economyPriority +
-                         simState.player2.blueCards * weights.victoryPointValue +
-                         simState.player2.greenCards * weights.sciencePriority +
-                         simState.player2.redCards * weights.militaryPriority;
-        if (simState.militaryPosition < 9) {
-            p1Score += (9 - simState.militaryPosition) * weights.militaryPriority;
-        } else {
-            p2Score += (simState.militaryPosition - 9) * weights.militaryPriority;
-        }
-        size_t p1ScienceTypes = simState.player1.scientificSymbols.size();
-        size_t p2ScienceTypes = simState.player2.scientificSymbols.size();
-        p1Score += p1ScienceTypes * weights.sciencePriority;
-        p2Score += p2ScienceTypes * weights.sciencePriority;
-        if (m_state.player1Turn) {
-            score = (p1Score > p2Score) ? 1.0 : (p1Score == p2Score ? 0.5 : 0.0);
-        } else {
-            score = (p2Score > p1Score) ? 1.0 : (p1Score == p2Score ? 0.5 : 0.0);
-        }
+        const double player1Value = evaluator(simState);
+        score = !m_state.player1Turn ? player1Value : 1.0 - player1Value;
     }
     return score;
 }
-void MCTSNode::backpropagate(double reward) {
+void MCTSNode::prove(ProvenValue value) {
+    MCTSNode* node = this;
+    while (node != nullptr) {
+        ProvenValue expected = ProvenValue::UNKNOWN;
+        if (!node->m_proven.compare_exchange_strong(expected, value, std::memory_order_acq_rel)) return;
+        MCTSNode* parent = node->m_parent;
+        if (parent == nullptr) return;
+        std::atomic_ref<ProvenValue>(parent->m_childStats.proven[node->m_slot]).store(value, std::memory_order_release);
+        if (value == ProvenValue::LOSS) {
+            const size_t losses = parent->m_provenLosses.fetch_add(1, std::memory_order_acq_rel) + 1;
+            if (losses < parent->m_state.availableActions.size()) return;
+        }
+        value = value == ProvenValue::WIN ? ProvenValue::LOSS : ProvenValue::WIN;
+        node = parent;
+    }
+}
+bool MCTSNode::seed(const MCTSAction& action, int visits, double meanValue) {
+    if (visits <= 0) return false;
+    for (MCTSNode* child : getChildren()) {
+        if (!(child->m_action == action)) continue;
+        const double total = meanValue * visits;
+        child->m_visits.fetch_add(visits, std::memory_order_relaxed);
+        child->m_totalValue.fetch_add(total, std::memory_order_relaxed);
+        m_childStats.visits[child->m_slot] += visits;
+        m_childStats.values[child->m_slot] += total;
+        m_childStats.squares[child->m_slot] += meanValue * total;
+        m_visits.fetch_add(visits, std::memory_order_relaxed);
+        m_totalValue.fetch_add(visits - total, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+void MCTSNode::backpropagate(double reward, int virtualLoss, TranspositionTable* table, AmafTrace* trace) {
+    if (m_state.isTerminal() && !isProven()) {
+        const int winner = MCTS::getWinner(m_state);
+        if (winner == 0 || winner == 1) {
+            prove((winner == 0) != m_state.player1Turn ? ProvenValue::WIN : ProvenValue::LOSS);
+        }
+    }
     MCTSNode* current = this;
     while (current != nullptr) {
-        current->m_visits++;
-        current->m_totalValue += reward;
+        current->m_visits.fetch_add(1, std::memory_order_relaxed);
+        current->m_totalValue.fetch_add(reward, std::memory_order_relaxed);
+        if (MCTSNode* parent = current->m_parent) {
+            const ChildStatistics& siblings = parent->m_childStats;
+            std::atomic_ref<int32_t>(siblings.visits[current->m_slot]).fetch_add(1, std::memory_order_relaxed);
+            std::atomic_ref<double>(siblings.values[current->m_slot]).fetch_add(reward, std::memory_order_relaxed);
+            std::atomic_ref<double>(siblings.squares[current->m_slot]).fetch_add(reward * reward, std::memory_order_relaxed);
+            if (virtualLoss != 0) {
+                std::atomic_ref<int32_t>(siblings.pending[current->m_slot]).fetch_sub(virtualLoss, std::memory_order_relaxed);
+            }
+        }
+        if (table) table->record(current->m_state.hash, reward);
+        if (virtualLoss != 0) current->m_virtualLoss.fetch_sub(virtualLoss, std::memory_order_relaxed);
+        if (trace) {
+            for (MCTSNode* child : current->getChildren()) {
+                if (!trace->contains(current->m_state.player1Turn, child->m_action)) continue;
+                child->m_amafVisits.fetch_add(1, std::memory_order_relaxed);
+                child->m_amafValue.fetch_add(1.0 - reward, std::memory_order_relaxed);
+            }
+            if (current->m_parent) trace->record(current->m_parent->m_state.player1Turn, current->m_action);
+        }
         reward = 1.0 - reward;
         current = current->m_parent;
     }
@@ -213,19 +1081,41 @@ MCTS::MCTS()
     : m_iterations(1000)
     , m_explorationConstant(1.414)
     , m_maxSimulationDepth(50)
+    , m_threadCount(1)
+    , m_parallelism(SearchParallelism::ROOT)
+    , m_virtualLoss(3)
     , m_rng(std::random_device{}())
     , m_playstyle(Playstyle::BRITNEY)
 {
 }
-MCTS::MCTS(int iterations, double explorationConstant, int maxSimulationDepth, Playstyle playstyle)
+MCTS::MCTS(int iterations, double explorationConstant, int maxSimulationDepth, Playstyle playstyle, int threadCount)
     : m_iterations(iterations)
     , m_explorationConstant(explorationConstant)
     , m_maxSimulationDepth(maxSimulationDepth)
+    , m_threadCount(threadCount)
+    , m_parallelism(SearchParallelism::ROOT)
+    , m_virtualLoss(3)
     , m_rng(std::random_device{}())
     , m_playstyle(playstyle)
 {
 }
+MCTS::~MCTS() {
+    stopPondering();
+}
 MCTSAction MCTS::search(const MCTSGameState& rootState) {
+    return runSearch(rootState, std::nullopt);
+}
+MCTSAction MCTS::searchFor(const MCTSGameState& rootState, std::chrono::milliseconds budget) {
+    return runSearch(rootState, budget);
+}
+bool MCTS::usesSharedTree() const {
+    const int threadCount = resolveThreadCount(m_threadCount);
+    const int determinizations = m_determinizations == DeterminizationPerThread ? threadCount : std::max(m_determinizations, 0);
+    return determinizations == 0 && threadCount > 1 && m_parallelism == SearchParallelism::TREE &&
+           m_searchPolicy.root == RootPolicy::TREE;
+}
+MCTSAction MCTS::runSearch(const MCTSGameState& rootState, std::optional<std::chrono::milliseconds> budget) {
+    stopPondering();
     MCTSGameState stateWithActions = cloneState(rootState);
     if (stateWithActions.availableActions.empty()) {
         stateWithActions.availableActions = getLegalActions(stateWithActions, stateWithActions.currentPhase);
@@ -233,105 +1123,354 @@ MCTSAction MCTS::search(const MCTSGameState& rootState) {
     if (stateWithActions.availableActions.empty()) {
         return MCTSAction{};
     }
-    auto root = std::make_unique<MCTSNode>(stateWithActions);
-    for (int i = 0; i < m_iterations; ++i) {
-        MCTSNode* node = root->select(m_explorationConstant);
-        if (!node->getState().isTerminal() && !node->isFullyExpanded()) {
-            node = node->expand();
+    const int threadCount = resolveThreadCount(m_threadCount);
+    const int determinizations = m_determinizations == DeterminizationPerThread ? threadCount : std::max(m_determinizations, 0);
+    const bool sharedTree = usesSharedTree();
+    const size_t treeCount = determinizations > 0 ? static_cast<size_t>(determinizations)
+                           : sharedTree ? 1 : static_cast<size_t>(threadCount);
+    std::vector<uint32_t> seeds(sharedTree ? static_cast<size_t>(threadCount) : treeCount);
+    for (auto& seed : seeds) seed = static_cast<uint32_t>(m_rng());
+    const int expectedIterations = budget ? static_cast<int>(m_lastStats.iterationsPerSecond * budget->count() / 1000.0)
+                                          : m_iterations * static_cast<int>(seeds.size());
+    const uint64_t cacheKey = m_positionCache ? positionCacheKey(canonicalHash(stateWithActions), m_playstyle,
+                                                                 toFeatureWeights(WeightsRegistry::current(m_playstyle).weights))
+                                              : 0;
+    const std::optional<CachedRoot> cached = m_positionCache ? m_positionCache->lookup(cacheKey) : std::nullopt;
+    auto& arenas = m_arenaBanks[1 - m_activeBank];
+    while (arenas.size() < seeds.size()) arenas.push_back(std::make_unique<MCTSArena>());
+    for (auto& arena : arenas) arena->reset();
+    std::vector<MCTSNode*> roots(treeCount, nullptr);
+    m_reusedVisits = 0;
+    for (size_t t = 0; t < treeCount; ++t) {
+        roots[t] = reuseSubtree(t, stateWithActions, *arenas[t]);
+        if (roots[t]) {
+            m_reusedVisits += roots[t]->getVisits();
+        } else if (determinizations > 0) {
+            MCTSGameState sampled = stateWithActions;
+            determinize(sampled, m_unseen, m_rng);
+            roots[t] = arenas[t]->create<MCTSNode>(sampled);
+        } else {
+            roots[t] = arenas[t]->create<MCTSNode>(stateWithActions);
+        }
+        if (cached && roots[t]->getVisits() == 0) {
+            const double cap = expectedIterations > 0 ? expectedIterations / 2.0 : static_cast<double>(cached->visits);
+            const double scale = std::min(1.0, cap / std::max<uint32_t>(cached->visits, 1)) / static_cast<double>(treeCount);
+            seedFromCache(*roots[t], *cached, scale, *arenas[t], m_widening);
+        }
+    }
+    m_activeBank = 1 - m_activeBank;
+    m_retainedRoots.clear();
+    std::vector<TranspositionTable*> tables(treeCount, nullptr);
+    if (m_useTranspositions) {
+        while (m_transpositions.size() < treeCount) m_transpositions.push_back(std::make_unique<TranspositionTable>());
+        for (size_t t = 0; t < treeCount; ++t) {
+            m_transpositions[t]->newSearch();
+            tables[t] = m_transpositions[t].get();
         }
-        double reward = node->simulate(m_rng, m_maxSimulationDepth);
-        node->backpropagate(reward);
     }
-    MCTSNode* bestChild = nullptr;
-    int maxVisits = -1;
-    for (const auto& child : root->getChildren()) {
-        if (child && child->getVisits() > maxVisits) {
-            maxVisits = child->getVisits();
-            bestChild = child.get();
+    const ActionList& rootActions = stateWithActions.availableActions;
+    std::vector<RootStatistics> trees(treeCount);
+    std::vector<SearchBudget> budgets(treeCount);
+    for (auto& treeBudget : budgets) {
+        initBudget(treeBudget, sharedTree ? m_iterations * threadCount : m_iterations, budget,
+                   m_clockCheckInterval, m_earlyStop);
+    }
+    const TreePolicy policy = makeTreePolicy(m_searchPolicy, m_widening, m_playout, m_rave, m_playstyle);
+    std::vector<SearchStats> workerStats(seeds.size());
+    const size_t arenasPerTree = sharedTree ? seeds.size() : 1;
+    for (auto& treeBudget : budgets) limitMemory(treeBudget, m_memoryLimit, seeds.size());
+    std::vector<RootStatistics> baselines(treeCount);
+    std::vector<RootStatistics> gained(treeCount);
+    for (size_t t = 0; t < treeCount; ++t) baselines[t] = collectRootStatistics(*roots[t], rootActions);
+    size_t peakBytes = 0;
+    int compactions = 0;
+    const auto searchStart = std::chrono::steady_clock::now();
+    while (true) {
+        if (sharedTree) {
+            trees[0] = searchSharedTree(*roots[0], rootActions, budgets[0], m_explorationConstant,
+                                        m_maxSimulationDepth, m_virtualLoss, tables[0], policy, seeds, arenas, workerStats);
+        } else if (treeCount == 1) {
+            trees[0] = searchTree(*roots[0], rootActions, budgets[0], m_explorationConstant, m_maxSimulationDepth, tables[0], policy, seeds[0], *arenas[0], workerStats[0]);
+        } else {
+            std::vector<std::jthread> workers;
+            workers.reserve(trees.size());
+            for (size_t t = 0; t < trees.size(); ++t) {
+                workers.emplace_back([&, t]() {
+                    trees[t] = searchTree(*roots[t], rootActions, budgets[t], m_explorationConstant, m_maxSimulationDepth, tables[t], policy, seeds[t], *arenas[t], workerStats[t]);
+                });
+            }
+        }
+        peakBytes = std::max(peakBytes, getArenaBytes());
+        bool compacted = false;
+        for (size_t t = 0; t < treeCount; ++t) {
+            if (!budgets[t].memoryFull.exchange(false, std::memory_order_relaxed)) continue;
+            addGained(gained[t], collectRootStatistics(*roots[t], rootActions), baselines[t]);
+            roots[t] = compactTree(*roots[t], t * arenasPerTree, arenasPerTree, peakBytes);
+            baselines[t] = collectRootStatistics(*roots[t], rootActions);
+            budgets[t].stop.store(false, std::memory_order_relaxed);
+            ++compactions;
+            compacted = true;
         }
+        if (!compacted) break;
     }
-    if (bestChild) {
-        std::cout << "[MCTS] Best action found with " << maxVisits << " visits out of " << m_iterations << " iterations\n";
-        return bestChild->getAction();
+    const double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - searchStart).count();
+    m_lastIterations = 0;
+    for (const auto& treeBudget : budgets) m_lastIterations += treeBudget.completed.load(std::memory_order_relaxed);
+    if (m_treeReuse) m_retainedRoots = roots;
+    const size_t actionCount = stateWithActions.availableActions.size();
+    std::vector<int> visits(actionCount, 0);
+    std::vector<double> values(actionCount, 0.0);
+    std::vector<size_t> provenWins(actionCount, 0);
+    std::vector<size_t> provenLosses(actionCount, 0);
+    std::vector<int> votes(actionCount, 0);
+    std::vector<int> newVisits(actionCount, 0);
+    std::vector<double> newValues(actionCount, 0.0);
+    for (size_t t = 0; t < treeCount; ++t) {
+        addGained(gained[t], trees[t], baselines[t]);
+        for (size_t a = 0; a < actionCount; ++a) {
+            newVisits[a] += gained[t].visits[a];
+            newValues[a] += gained[t].values[a];
+        }
+    }
+    for (const auto& tree : trees) {
+        for (size_t a = 0; a < actionCount; ++a) {
+            visits[a] += tree.visits[a];
+            votes[a] += tree.votes[a];
+            values[a] += tree.values[a];
+            if (tree.proven[a] == ProvenValue::WIN) ++provenWins[a];
+            if (tree.proven[a] == ProvenValue::LOSS) ++provenLosses[a];
+        }
+    }
+    const size_t proofQuorum = determinizations > 0 ? treeCount : 1;
+    auto bestBy = [&](auto&& eligible) {
+        size_t best = actionCount;
+        for (size_t a = 0; a < actionCount; ++a) {
+            if (!eligible(a) || visits[a] == 0) continue;
+            if (best == actionCount || std::pair(votes[a], visits[a]) > std::pair(votes[best], visits[best])) best = a;
+        }
+        return best;
+    };
+    size_t bestIndex = bestBy([&](size_t a) { return provenWins[a] >= proofQuorum; });
+    const bool provenWin = bestIndex < actionCount;
+    if (!provenWin) bestIndex = bestBy([&](size_t a) { return provenLosses[a] < proofQuorum; });
+    if (bestIndex == actionCount) bestIndex = bestBy([](size_t) { return true; });
+    const int maxVisits = bestIndex < actionCount ? visits[bestIndex] : 0;
+    SearchStats stats;
+    for (const auto& worker : workerStats) stats.merge(worker);
+    stats.extrapolatePhaseTimes();
+    stats.wallMs = elapsedMs;
+    stats.iterationsPerSecond = elapsedMs > 0.0 ? stats.iterations * 1000.0 / elapsedMs : 0.0;
+    stats.nodesAllocated = getNodeCount();
+    stats.bytesUsed = getArenaBytes();
+    stats.peakBytes = std::max(peakBytes, stats.bytesUsed);
+    stats.compactions = compactions;
+    stats.reusedVisits = m_reusedVisits;
+    stats.ponderedIterations = m_ponderedIterations;
+    m_ponderedIterations = 0;
+    stats.provenWin = provenWin;
+    int totalVisits = 0;
+    double totalValue = 0.0;
+    for (size_t a = 0; a < actionCount; ++a) {
+        totalVisits += visits[a];
+        totalValue += values[a];
+    }
+    if (totalVisits > 0) stats.rootValue = totalValue / totalVisits;
+    if (bestIndex < actionCount) {
+        stats.bestVisits = maxVisits;
+        stats.bestNewVisits = newVisits[bestIndex];
+        stats.bestValue = values[bestIndex] / maxVisits;
+    }
+    m_lastStats = stats;
+    if (m_positionCache) {
+        const CachedRoot searched = summarizeRoot(stateWithActions.availableActions, newVisits, newValues);
+        if (!cached || searched.visits >= cached->visits) m_positionCache->store(cacheKey, searched);
+    }
+    if (bestIndex < actionCount) {
+        std::cout << "[MCTS] Best action found with " << maxVisits << " visits out of "
+                  << m_lastIterations << " iterations in " << static_cast<int>(elapsedMs) << " ms (";
+        if (determinizations > 0) std::cout << determinizations << " determinizations)\n";
+        else std::cout << threadCount << " threads, " << (sharedTree ? "shared tree" : "root-parallel") << ")\n";
+        m_lastAction = stateWithActions.availableActions[bestIndex];
+        return m_lastAction;
     }
     std::cout << "[MCTS] No best child found, using first action\n";
-    return stateWithActions.availableActions[0];
+    m_lastAction = stateWithActions.availableActions[0];
+    return m_lastAction;
+}
+struct PonderTask {
+    explicit PonderTask(size_t trees) : budgets(trees), stats(trees) {}
+    std::vector<SearchBudget> budgets;
+    std::vector<SearchStats> stats;
+    TreePolicy policy;
+    std::vector<std::jthread> workers;
+};
+bool MCTS::startPondering() {
+    stopPondering();
+    if (!m_treeReuse || m_ponderIterations <= 0) return false;
+    const auto& arenas = m_arenaBanks[m_activeBank];
+    std::vector<std::pair<size_t, MCTSNode*>> ponderRoots;
+    for (size_t t = 0; t < m_retainedRoots.size() && t < arenas.size(); ++t) {
+        if (!m_retainedRoots[t]) continue;
+        for (MCTSNode* ourMove : m_retainedRoots[t]->getChildren()) {
+            if (ourMove->getAction() == m_lastAction && !ourMove->getState().isTerminal()) {
+                ponderRoots.emplace_back(t, ourMove);
+                break;
+            }
+        }
+    }
+    if (ponderRoots.empty()) return false;
+    m_ponder = std::make_unique<PonderTask>(ponderRoots.size());
+    m_ponder->policy = makeTreePolicy(m_searchPolicy, m_widening, m_playout, m_rave, m_playstyle);
+    const int perTree = std::max(m_ponderIterations / static_cast<int>(ponderRoots.size()), 1);
+    m_ponder->workers.reserve(ponderRoots.size());
+    for (size_t p = 0; p < ponderRoots.size(); ++p) {
+        const auto [tree, root] = ponderRoots[p];
+        initBudget(m_ponder->budgets[p], perTree, std::nullopt, m_clockCheckInterval, false);
+        limitMemory(m_ponder->budgets[p], m_memoryLimit, m_retainedRoots.size());
+        TranspositionTable* table = m_useTranspositions && tree < m_transpositions.size() ? m_transpositions[tree].get() : nullptr;
+        MCTSArena* arena = arenas[tree].get();
+        const uint32_t seed = static_cast<uint32_t>(m_rng());
+        m_ponder->workers.emplace_back([this, task = m_ponder.get(), p, root, table, arena, seed]() {
+            std::mt19937 rng(seed);
+            task->policy.iterate(*root, task->budgets[p], m_explorationConstant, m_maxSimulationDepth, 0, table,
+                                 task->policy, rng, *arena, task->stats[p]);
+        });
+    }
+    return true;
+}
+void MCTS::stopPondering() {
+    if (!m_ponder) return;
+    for (auto& treeBudget : m_ponder->budgets) treeBudget.stop.store(true, std::memory_order_relaxed);
+    m_ponder->workers.clear();
+    m_ponderedIterations = 0;
+    for (const auto& treeBudget : m_ponder->budgets) m_ponderedIterations += treeBudget.completed.load(std::memory_order_relaxed);
+    m_ponder.reset();
+}
+MCTSNode* MCTS::reuseSubtree(size_t tree, const MCTSGameState& observed, MCTSArena& arena) const {
+    if (!m_treeReuse || tree >= m_retainedRoots.size() || !m_retainedRoots[tree]) return nullptr;
+    for (MCTSNode* ourMove : m_retainedRoots[tree]->getChildren()) {
+        if (!(ourMove->getAction() == m_lastAction)) continue;
+        for (MCTSNode* reply : ourMove->getChildren()) {
+            if (!matchesObservedPosition(reply->getState(), observed)) continue;
+            if (reply->getState().availableActions.size() != observed.availableActions.size()) return nullptr;
+            MCTSGameState rootState = observed;
+            for (size_t age = 0; age < rootState.pyramids.size(); ++age) {
+                AgePyramid& pyramid = rootState.pyramids[age];
+                for (uint32_t hidden = pyramid.remaining & pyramid.hidden; hidden != 0; hidden &= hidden - 1) {
+                    const size_t slot = static_cast<size_t>(std::countr_zero(hidden));
+                    pyramid.cardIds[slot] = reply->getState().pyramids[age].cardIds[slot];
+                }
+            }
+            return MCTSNode::cloneSubtree(*reply, nullptr, arena, &rootState);
+        }
+        return nullptr;
+    }
+    return nullptr;
+}
+MCTSNode* MCTS::compactTree(const MCTSNode& root, size_t firstArena, size_t arenaCount, size_t& peakBytes) {
+    auto& active = m_arenaBanks[m_activeBank];
+    auto& spare = m_arenaBanks[1 - m_activeBank];
+    while (spare.size() < active.size()) spare.push_back(std::make_unique<MCTSArena>());
+    for (size_t a = firstArena; a < firstArena + arenaCount; ++a) spare[a]->reset();
+    MCTSNode* compacted = MCTSNode::cloneSubtree(root, nullptr, *spare[firstArena], nullptr,
+                                                 retentionThreshold(root, m_memoryLimit.retainFraction));
+    peakBytes = std::max(peakBytes, getArenaBytes() + spare[firstArena]->getAllocatedBytes());
+    for (size_t a = firstArena; a < firstArena + arenaCount; ++a) {
+        std::swap(active[a], spare[a]);
+        spare[a]->reset();
+    }
+    return compacted;
+}
+size_t MCTS::getNodeCount() const {
+    size_t total = 0;
+    for (const auto& arena : m_arenaBanks[m_activeBank]) total += arena->getObjectCount();
+    return total;
+}
+size_t MCTS::getArenaBytes() const {
+    size_t total = 0;
+    for (const auto& arena : m_arenaBanks[m_activeBank]) total += arena->getAllocatedBytes();
+    return total;
+}
+size_t MCTS::getArenaReservedBytes() const {
+    size_t total = 0;
+    for (const auto& arena : m_arenaBanks[m_activeBank]) total += arena->getReservedBytes();
+    return total;
 }
 MCTSGameState MCTS::captureGameState(int currentPhase, bool isPlayer1Turn) {
     MCTSGameState state;
     auto& gameState = Core::GameState::getInstance();
     auto& board = Core::Board::getInstance();
-    state.currentPhase = currentPhase;
+    state.currentPhase = static_cast<uint8_t>(currentPhase);
     state.player1Turn = isPlayer1Turn;
-    state.militaryPosition = board.getPawnPos();
-    state.roundsRemaining = 20; 
+    state.militaryPosition = static_cast<int8_t>(board.getPawnPos());
     state.gameOver = false;
     state.winner = -1;
-    if (auto* p1 = gameState.GetPlayer1()->m_player.get()) {
-        state.player1.coins = p1->totalCoins(p1->getRemainingCoins());
-        state.player1.cardCount = static_cast<uint8_t>(p1->getOwnedCards().size());
-        state.player1.wonderCount = static_cast<uint8_t>(p1->getOwnedWonders().size());
-        state.player1.tokenCount = static_cast<uint8_t>(p1->getOwnedTokens().size());
-        for (const auto& w : p1->getOwnedWonders()) {
-            if (!w) continue;
-            state.player1.ownedWonders.push_back(extractCardInfo(w.get()));
-        }
-        for (const auto& card : p1->getOwnedCards()) {
-            if (!card) continue;
-            switch (card->getColor()) {
-                case Models::ColorType::BLUE: state.player1.blueCards++; break;
-                case Models::ColorType::GREEN: state.player1.greenCards++; break;
-                case Models::ColorType::RED: state.player1.redCards++; break;
-                case Models::ColorType::YELLOW: state.player1.yellowCards++; break;
-                case Models::ColorType::PURPLE: state.player1.purpleCards++; break;
-                case Models::ColorType::BROWN: state.player1.brownCards++; break;
-                case Models::ColorType::GREY: state.player1.greyCards++; break;
-                default: break;
-            }
-        }
-        state.player1.permanentResources = p1->getOwnedPermanentResources();
-        state.player1.tradingResources = p1->getOwnedTradingResources();
-        state.player1.scientificSymbols = p1->getOwnedScientificSymbols();
-        const auto& pts1 = p1->getPoints();
-        state.player1.militaryVP = pts1.m_militaryVictoryPoints;
-        state.player1.buildingVP = pts1.m_buildingVictoryPoints;
-        state.player1.wonderVP = pts1.m_wonderVictoryPoints;
-        state.player1.progressVP = pts1.m_progressVictoryPoints;
-    }
-    if (auto* p2 = gameState.GetPlayer2()->m_player.get()) {
-        state.player2.coins = p2->totalCoins(p2->getRemainingCoins());
-        state.player2.cardCount = static_cast<uint8_t>(p2->getOwnedCards().size());
-        state.player2.wonderCount = static_cast<uint8_t>(p2->getOwnedWonders().size());
-        state.player2.tokenCount = static_cast<uint8_t>(p2->getOwnedTokens().size());
-        for (const auto& w : p2->getOwnedWonders()) {
-            if (!w) continue;
-            state.player2.ownedWonders.push_back(extractCardInfo(w.get()));
-        }
-        for (const auto& card : p2->getOwnedCards()) {
+    const std::array<const std::vector<std::shared_ptr<Node>>*, 3> ageNodes = {
+        &board.getAge1Nodes(), &board.getAge2Nodes(), &board.getAge3Nodes()
+    };
+    int cardsLeft = 0;
+    for (int age = std::max(currentPhase, 1); age <= 3; ++age) {
+        AgePyramid& pyramid = state.pyramids[age - 1];
+        const auto& nodes = *ageNodes[age - 1];
+        for (size_t i = 0; i < nodes.size() && i < AgePyramid::MaxSlots; ++i) {
+            if (!nodes[i]) continue;
+            const Models::Card* card = nodes[i]->getCardRaw();
             if (!card) continue;
-            switch (card->getColor()) {
-                case Models::ColorType::BLUE: state.player2.blueCards++; break;
-                case Models::ColorType::GREEN: state.player2.greenCards++; break;
-                case Models::ColorType::RED: state.player2.redCards++; break;
-                case Models::ColorType::YELLOW: state.player2.yellowCards++; break;
-                case Models::ColorType::PURPLE: state.player2.purpleCards++; break;
-                case Models::ColorType::BROWN: state.player2.brownCards++; break;
-                case Models::ColorType::GREY: state.player2.greyCards++; break;
-                default: break;
-            }
-        }
-        state.player2.permanentResources = p2->getOwnedPermanentResources();
-        state.player2.tradingResources = p2->getOwnedTradingResources();
-        state.player2.scientificSymbols = p2->getOwnedScientificSymbols();
-        const auto& pts2 = p2->getPoints();
-        state.player2.militaryVP = pts2.m_militaryVictoryPoints;
-        state.player2.buildingVP = pts2.m_buildingVictoryPoints;
-        state.player2.wonderVP = pts2.m_wonderVictoryPoints;
-        state.player2.progressVP = pts2.m_progressVictoryPoints;
+            uint8_t id = MCTSCardCatalog::intern(*card);
+            if (id == MCTSCardCatalog::NoCard) continue;
+            pyramid.cardIds[i] = id;
+            pyramid.remaining |= 1u << i;
+            if (age > currentPhase || !card->isVisible()) pyramid.hidden |= 1u << i;
+        }
+        refreshAvailability(pyramid, getPyramidTopology(age));
+        cardsLeft += std::popcount(pyramid.remaining);
     }
+    state.roundsRemaining = static_cast<int8_t>(cardsLeft);
+    if (auto* p1 = gameState.GetPlayer1()->m_player.get()) capturePlayer(state.player1, *p1);
+    if (auto* p2 = gameState.GetPlayer2()->m_player.get()) capturePlayer(state.player2, *p2);
+    state.hash = computeHash(state);
+    state.features = computeFeatures(state);
     return state;
 }
-void MCTS::saveCurrentState(MCTSGameState& mctsState) {
+UnseenCards MCTS::captureUnseenCards() {
+    UnseenCards unseen;
+    auto& board = Core::Board::getInstance();
+    const std::array<const std::vector<std::unique_ptr<Models::Card>>*, UnseenCards::Pools> pools = {
+        &board.getUnusedAgeOneCards(), &board.getUnusedAgeTwoCards(), &board.getUnusedAgeThreeCards(), &board.getUnusedGuildCards()
+    };
+    for (size_t pool = 0; pool < pools.size(); ++pool) {
+        for (const auto& card : *pools[pool]) {
+            if (!card) continue;
+            uint8_t id = MCTSCardCatalog::intern(*card);
+            if (id != MCTSCardCatalog::NoCard) unseen.add(pool, id);
+        }
+    }
+    return unseen;
+}
+void MCTS::determinize(MCTSGameState& state, const UnseenCards& unseen, std::mt19937& rng) {
+    constexpr size_t MaxCandidates = AgePyramid::MaxSlots * 3 + UnseenCards::MaxPerPool;
+    for (size_t pool = 0; pool < UnseenCards::Pools; ++pool) {
+        std::array<uint8_t*, AgePyramid::MaxSlots * 3> slots{};
+        std::array<uint8_t, MaxCandidates> candidates{};
+        size_t slotCount = 0;
+        for (size_t age = 0; age < state.pyramids.size(); ++age) {
+            AgePyramid& pyramid = state.pyramids[age];
+            for (uint32_t hidden = pyramid.remaining & pyramid.hidden; hidden != 0; hidden &= hidden - 1) {
+                uint8_t& cardId = pyramid.cardIds[static_cast<size_t>(std::countr_zero(hidden))];
+                if (unseenPool(age, cardId) != pool) continue;
+                candidates[slotCount] = cardId;
+                slots[slotCount++] = &cardId;
+            }
+        }
+        if (slotCount == 0) continue;
+        size_t candidateCount = slotCount;
+        for (size_t i = 0; i < unseen.counts[pool]; ++i) candidates[candidateCount++] = unseen.cardIds[pool][i];
+        std::shuffle(candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(candidateCount), rng);
+        for (size_t i = 0; i < slotCount; ++i) *slots[i] = candidates[i];
+    }
+    state.hash = computeHash(state);
+}
+std::string MCTS::saveCurrentState() {
     auto& gameState = GameState::getInstance();
     gameState.saveGameState("temp_mcts_state.csv");
     std::ostringstream oss;
@@ -341,11 +1480,11 @@ void MCTS::saveCurrentState(MCTSGameState& mctsState) {
     auto player2 = gameState.GetPlayer2();
     if (player1) oss << *player1;
     if (player2) oss << *player2;
-    mctsState.serializedState = oss.str();
+    return oss.str();
 }
-void MCTS::restoreState(const MCTSGameState& mctsState) {
-    if (mctsState.serializedState.empty()) return;
-    std::istringstream iss(mctsState.serializedState);
+void MCTS::restoreState(const std::string& serializedState) {
+    if (serializedState.empty()) return;
+    std::istringstream iss(serializedState);
     auto& gameState = GameState::getInstance();
     auto& board = Board::getInstance();
     iss >> board;
@@ -354,46 +1493,45 @@ void MCTS::restoreState(const MCTSGameState& mctsState) {
     if (player1) iss >> *player1;
     if (player2) iss >> *player2;
 }
-std::vector<MCTSAction> MCTS::getLegalActions(const MCTSGameState& state, int currentPhase) {
-    std::vector<MCTSAction> actions;
-    auto& board = Board::getInstance();
-    const std::vector<std::shared_ptr<Node>>* nodes = nullptr;
-    switch (currentPhase) {
-        case 1: nodes = &board.getAge1Nodes(); break;
-        case 2: nodes = &board.getAge2Nodes(); break;
-        case 3: nodes = &board.getAge3Nodes(); break;
-        default: return actions; 
-    }
-    if (!nodes) return actions;
-    for (size_t i = 0; i < nodes->size(); ++i) {
-        const auto& node = (*nodes)[i];
-        if (!node) continue;
-        if (!node->isAvailable()) continue;
-        const auto card = node->getCard();
-        if (!card.has_value()) continue;
-        MCTSAction buildAction;
-        buildAction.cardNodeIndex = i;
-        buildAction.actionType = 0;
-        buildAction.cardName = card->get().getName();
-        buildAction.cardColor = card->get().getColor();
-        buildAction.expectedVP = card->get().getVictoryPoints();
-        actions.push_back(buildAction);
+ActionList MCTS::getLegalActions(const MCTSGameState& state, int currentPhase) {
+    ActionList actions;
+    if (currentPhase < 1 || currentPhase > 3) return actions;
+    const AgePyramid& pyramid = state.pyramids[currentPhase - 1];
+    const PlayerInfo& currentPlayer = state.getCurrentPlayer();
+    const PlayerInfo& opponent = state.getOpponent();
+    std::array<bool, PlayerInfo::MaxWonders> wonderAffordable{};
+    for (uint8_t w = 0; w < currentPlayer.wonderCount; ++w) {
+        const CardInfo& wonder = MCTSCardCatalog::get(currentPlayer.wonderIds[w]);
+        wonderAffordable[w] = wonderCost(currentPlayer, opponent, wonder) <= currentPlayer.coins;
+    }
+    for (uint32_t bits = pyramid.available; bits != 0; bits &= bits - 1) {
+        size_t i = static_cast<size_t>(std::countr_zero(bits));
+        uint8_t cardId = pyramid.cardIds[i];
+        const CardInfo& card = MCTSCardCatalog::get(cardId);
+        if (cardCost(currentPlayer, opponent, card) <= currentPlayer.coins) {
+            MCTSAction buildAction;
+            buildAction.cardNodeIndex = static_cast<uint8_t>(i);
+            buildAction.actionType = 0;
+            buildAction.cardId = cardId;
+            buildAction.cardColor = card.color;
+            buildAction.expectedVP = card.victoryPoints;
+            actions.push_back(buildAction);
+        }
         MCTSAction sellAction;
-        sellAction.cardNodeIndex = i;
+        sellAction.cardNodeIndex = static_cast<uint8_t>(i);
         sellAction.actionType = 1;
-        sellAction.cardName = card->get().getName();
-        sellAction.cardColor = card->get().getColor();
+        sellAction.cardId = cardId;
+        sellAction.cardColor = card.color;
         actions.push_back(sellAction);
-        const PlayerInfo& currentPlayer = state.getCurrentPlayer();
-        for (size_t w = 0; w < currentPlayer.ownedWonders.size(); ++w) {
-            if (!currentPlayer.ownedWonders[w].isConstructed) {
+        for (uint8_t w = 0; w < currentPlayer.wonderCount; ++w) {
+            if (!currentPlayer.isWonderConstructed(w) && wonderAffordable[w]) {
                 MCTSAction wonderAction;
-                wonderAction.cardNodeIndex = i;
+                wonderAction.cardNodeIndex = static_cast<uint8_t>(i);
                 wonderAction.actionType = 2;
                 wonderAction.wonderIndex = w;
-                wonderAction.cardName = card->get().getName();
-                wonderAction.cardColor = card->get().getColor();
-                wonderAction.expectedVP = currentPlayer.ownedWonders[w].victoryPoints;
+                wonderAction.cardId = cardId;
+                wonderAction.cardColor = card.color;
+                wonderAction.expectedVP = MCTSCardCatalog::get(currentPlayer.wonderIds[w]).victoryPoints;
                 actions.push_back(wonderAction);
             }
         }
@@ -402,48 +1540,82 @@ std::vector<MCTSAction> MCTS::getLegalActions(const MCTSGameState& state, int cu
 }
 void MCTS::applyAction(MCTSGameState& state, const MCTSAction& action) {
     PlayerInfo& currentPlayer = state.getCurrentPlayerMut();
-    PlayerInfo& opponent = state.getOpponentMut();
+    const PlayerInfo moverBefore = currentPlayer;
+    const size_t moverSide = state.player1Turn ? 0 : 1;
+    const uint64_t globalsBefore = hashGlobals(state);
+    auto movePawn = [&state](uint8_t shields) {
+        if (shields == 0) return;
+        int steps = state.player1Turn ? static_cast<int>(shields) : -static_cast<int>(shields);
+        state.militaryPosition = static_cast<int8_t>(std::clamp(state.militaryPosition + steps, 0, 18));
+    };
     if (action.actionType == 0) { 
-        CardInfo newCard;
-        newCard.name = action.cardName;
-        newCard.color = action.cardColor;
-        newCard.victoryPoints = action.expectedVP;
-        currentPlayer.ownedCards.push_back(newCard);
+        const CardInfo& newCard = MCTSCardCatalog::get(action.cardId);
+        const Models::ColorType color = action.cardId == MCTSCardCatalog::NoCard ? action.cardColor : newCard.color;
+        const uint8_t victoryPoints = action.cardId == MCTSCardCatalog::NoCard ? action.expectedVP : newCard.victoryPoints;
+        const bool chained = newCard.requiredLinkingSymbol != Models::LinkingSymbolType::NO_SYMBOL &&
+                             currentPlayer.hasLinkingSymbol(newCard.requiredLinkingSymbol);
+        const int cost = cardCost(currentPlayer, state.getOpponent(), newCard);
+        currentPlayer.coins -= static_cast<uint8_t>(std::min<int>(cost, currentPlayer.coins));
+        if (chained && currentPlayer.hasProgressToken(static_cast<size_t>(Models::TokenIndex::URBANISM))) currentPlayer.coins += 4;
+        if (newCard.linkingSymbol != Models::LinkingSymbolType::NO_SYMBOL) currentPlayer.addLinkingSymbol(newCard.linkingSymbol);
+        currentPlayer.fixedPriceResources |= newCard.fixedPriceResources;
+        if (color == Models::ColorType::BROWN || color == Models::ColorType::GREY) {
+            for (size_t res = 0; res < ResourceSlots; ++res) {
+                currentPlayer.brownGreyProduction[res] += newCard.resourcesProduction[res];
+            }
+        }
         currentPlayer.cardCount++;
-        switch (action.cardColor) {
-            case Models::ColorType::BROWN: currentPlayer.brownCards++; break;
-            case Models::ColorType::GREY: currentPlayer.greyCards++; break;
-            case Models::ColorType::BLUE: currentPlayer.blueCards++; break;
-            case Models::ColorType::RED: currentPlayer.redCards++; break;
-            case Models::ColorType::GREEN: currentPlayer.greenCards++; break;
-            case Models::ColorType::YELLOW: currentPlayer.yellowCards++; break;
-            case Models::ColorType::PURPLE: currentPlayer.purpleCards++; break;
-            default: break;
+        addColorCount(currentPlayer, color);
+        currentPlayer.buildingVP += victoryPoints;
+        if (color == Models::ColorType::BLUE) currentPlayer.blueVP += victoryPoints;
+        for (size_t res = 0; res < ResourceSlots; ++res) {
+            currentPlayer.permanentResources[res] += newCard.resourcesProduction[res];
+        }
+        if (newCard.hasScientificSymbol) {
+            currentPlayer.addScientificSymbol(newCard.scientificSymbol);
         }
+        movePawn(newCard.shieldPoints);
     } else if (action.actionType == 1) { 
         uint8_t coinsGained = static_cast<uint8_t>(2 + currentPlayer.yellowCards);
         currentPlayer.coins += coinsGained;
     } else if (action.actionType == 2) { 
-        if (action.wonderIndex < currentPlayer.ownedWonders.size()) {
-            currentPlayer.ownedWonders[action.wonderIndex].isConstructed = true;
-            currentPlayer.wonderVP += currentPlayer.ownedWonders[action.wonderIndex].victoryPoints;
+        if (action.wonderIndex < currentPlayer.wonderCount && !currentPlayer.isWonderConstructed(action.wonderIndex)) {
+            const CardInfo& wonder = MCTSCardCatalog::get(currentPlayer.wonderIds[action.wonderIndex]);
+            const int cost = wonderCost(currentPlayer, state.getOpponent(), wonder);
+            currentPlayer.coins -= static_cast<uint8_t>(std::min<int>(cost, currentPlayer.coins));
+            currentPlayer.constructedWonders |= static_cast<uint8_t>(1u << action.wonderIndex);
+            currentPlayer.wonderVP += wonder.victoryPoints;
+            for (size_t res = 0; res < ResourceSlots; ++res) {
+                currentPlayer.permanentResources[res] += wonder.resourcesProduction[res];
+            }
+            movePawn(wonder.shieldPoints);
         }
     }
+    if (state.currentPhase >= 1 && state.currentPhase <= 3 && action.cardNodeIndex < AgePyramid::MaxSlots) {
+        AgePyramid& pyramid = state.pyramids[state.currentPhase - 1];
+        if ((pyramid.remaining >> action.cardNodeIndex) & 1u) {
+            takeFromPyramid(pyramid, getPyramidTopology(state.currentPhase), action.cardNodeIndex);
+            state.hash ^= zobristKeys().slots[state.currentPhase - 1][action.cardNodeIndex][pyramid.cardIds[action.cardNodeIndex]];
+        }
+        while (state.currentPhase < 3 && state.pyramids[state.currentPhase - 1].isEmpty()) {
+            state.currentPhase++;
+        }
+        if (state.pyramids[state.currentPhase - 1].isEmpty()) {
+            state.gameOver = true;
+        }
+    }
+    state.availableActions.clear();
     state.player1Turn = !state.player1Turn;
     state.roundsRemaining--;
     if (state.roundsRemaining <= 0) {
         state.gameOver = true;
     }
-    if (state.militaryPosition <= 0 || state.militaryPosition >= 18) {
+    if (hasMilitaryVictory(state.militaryPosition, true) || hasMilitaryVictory(state.militaryPosition, false)) {
         state.gameOver = true;
-        state.winner = (state.militaryPosition <= 0) ? 0 : 1;
+        state.winner = hasMilitaryVictory(state.militaryPosition, true) ? 0 : 1;
     }
     auto checkScience = [](const PlayerInfo& p) -> bool {
-        size_t uniqueSymbols = 0;
-        for (const auto& [symbol, count] : p.scientificSymbols) {
-            if (count > 0) uniqueSymbols++;
-        }
-        return uniqueSymbols >= 6;
+        return p.scientificSymbolCount() >= 6;
     };
     if (checkScience(state.player1) && checkScience(state.player2)) {
         state.gameOver = true;
@@ -455,6 +1627,11 @@ void MCTS::applyAction(MCTSGameState& state, const MCTSAction& action) {
         state.gameOver = true;
         state.winner = 1;
     }
+    state.hash ^= hashPlayerDelta(moverBefore, currentPlayer, moverSide) ^ globalsBefore ^ hashGlobals(state);
+    const int moverSign = moverSide == 0 ? 1 : -1;
+    addPlayerFeatures(state.features, moverBefore, -moverSign);
+    addPlayerFeatures(state.features, currentPlayer, moverSign);
+    state.features[static_cast<size_t>(EvalFeature::MILITARY)] = static_cast<int16_t>(militaryLead(state.militaryPosition, true));
 }
 bool MCTS::isTerminal(const MCTSGameState& state) {
     return state.isTerminal();
@@ -473,54 +1650,96 @@ int MCTS::getWinner(const MCTSGameState& state) {
     uint32_t score2 = calculateScore(state.player2);
     if (score1 > score2) return 0;
     if (score2 > score1) return 1;
-    uint8_t blue1 = 0, blue2 = 0;
-    for (const auto& card : state.player1.ownedCards) {
-        if (card.color == Models::ColorType::BLUE) blue1 += card.victoryPoints;
-    }
-    for (const auto& card : state.player2.ownedCards) {
-        if (card.color == Models::ColorType::BLUE) blue2 += card.victoryPoints;
-    }
-    if (blue1 > blue2) return 0;
-    if (blue2 > blue1) return 1;
+    if (state.player1.blueVP > state.player2.blueVP) return 0;
+    if (state.player2.blueVP > state.player1.blueVP) return 1;
     return 2; 
 }
 MCTSGameState MCTS::cloneState(const MCTSGameState& state) {
     return state.clone();
 }
-double MCTS::evaluateState(const MCTSGameState& state, bool forPlayer1) const {
-    const PlayerInfo& player = forPlayer1 ? state.player1 : state.player2;
-    const PlayerInfo& opponent = forPlayer1 ? state.player2 : state.player1;
-    AIConfig config(m_playstyle);
-    auto weights = config.getWeights();
-    double myScore = player.coins * weights.coinValue +
-                     player.cardCount * weights.economyPriority +
-                     player.blueCards * weights.victoryPointValue +
-                     player.greenCards * weights.sciencePriority +
-                     player.redCards * weights.militaryPriority +
-                     player.yellowCards * weights.economyPriority +
-                     player.buildingVP * weights.victoryPointValue +
-                     player.wonderVP * weights.wonderVPBonus;
-    double oppScore = opponent.coins * weights.coinValue +
-                      opponent.cardCount * weights.economyPriority +
-                      opponent.blueCards * weights.victoryPointValue +
-                      opponent.greenCards * weights.sciencePriority +
-                      opponent.redCards * weights.militaryPriority +
-                      opponent.yellowCards * weights.economyPriority +
-                      opponent.buildingVP * weights.victoryPointValue +
-                      opponent.wonderVP * weights.wonderVPBonus;
-    double militaryBonus = evaluateMilitaryPosition(state.militaryPosition, forPlayer1);
-    myScore += militaryBonus * weights.militaryPriority;
-    double scienceBonus = evaluateScientificProgress(player);
-    myScore += scienceBonus * weights.sciencePriority;
-    for (const auto& [res, qty] : player.permanentResources) {
-        myScore += qty * weights.resourceValue;
-    }
-    for (const auto& [res, qty] : opponent.permanentResources) {
-        oppScore += qty * weights.resourceValue;
-    }
-    return (myScore - oppScore) / (myScore + oppScore + 1.0);
-}
-double MCTS::evaluateResourceDenial(const MCTSGameState& state, const MCTSAction& action) const {
+uint64_t MCTS::computeHash(const MCTSGameState& state) {
+    const auto& keys = zobristKeys();
+    uint64_t hash = hashPlayer(state.player1, 0) ^ hashPlayer(state.player2, 1) ^ hashGlobals(state);
+    for (size_t age = 0; age < state.pyramids.size(); ++age) {
+        const AgePyramid& pyramid = state.pyramids[age];
+        for (uint32_t bits = pyramid.remaining; bits != 0; bits &= bits - 1) {
+            const size_t slot = static_cast<size_t>(std::countr_zero(bits));
+            hash ^= keys.slots[age][slot][pyramid.cardIds[slot]];
+        }
+    }
+    return hash;
+}
+uint64_t MCTS::canonicalHash(const MCTSGameState& state) {
+    uint64_t hash = 0;
+    for (const PlayerInfo* player : { &state.player1, &state.player2 }) {
+        PlayerInfo canonical = *player;
+        canonical.wonderIds.fill(0);
+        const auto* bytes = reinterpret_cast<const unsigned char*>(&canonical);
+        for (size_t i = 0; i < sizeof(PlayerInfo); i += sizeof(uint32_t)) {
+            uint32_t word = 0;
+            for (size_t b = 0; b < sizeof(uint32_t) && i + b < sizeof(PlayerInfo); ++b) word |= static_cast<uint32_t>(bytes[i + b]) << (8 * b);
+            hash = mixHash(hash, word);
+        }
+        for (size_t i = 0; i < player->wonderCount; ++i) hash = mixHash(hash, cardNameHash(player->wonderIds[i]));
+    }
+    hash = mixHash(hash, static_cast<uint64_t>(static_cast<uint8_t>(state.militaryPosition)) |
+                         static_cast<uint64_t>(state.currentPhase) << 8 |
+                         static_cast<uint64_t>(state.player1Turn) << 16 |
+                         static_cast<uint64_t>(state.gameOver) << 24 |
+                         static_cast<uint64_t>(static_cast<uint8_t>(state.winner)) << 32);
+    for (size_t age = 0; age < state.pyramids.size(); ++age) {
+        const AgePyramid& pyramid = state.pyramids[age];
+        hash = mixHash(hash, static_cast<uint64_t>(pyramid.remaining) | static_cast<uint64_t>(pyramid.remaining & pyramid.hidden) << 32);
+        for (uint32_t revealed = pyramid.remaining & ~pyramid.hidden; revealed != 0; revealed &= revealed - 1) {
+            const size_t slot = static_cast<size_t>(std::countr_zero(revealed));
+            hash = mixHash(hash, cardNameHash(pyramid.cardIds[slot]) + slot);
+        }
+    }
+    return hash != 0 ? hash : 1;
+}
+FeatureVector MCTS::computeFeatures(const MCTSGameState& state) {
+    FeatureVector features{};
+    addPlayerFeatures(features, state.player1, 1);
+    addPlayerFeatures(features, state.player2, -1);
+    features[static_cast<size_t>(EvalFeature::MILITARY)] = static_cast<int16_t>(militaryLead(state.militaryPosition, true));
+    return features;
+}
+double MCTS::evaluateFeatures(const MCTSGameState& state, const AIWeights& weights) {
+    return LearnedEvaluator(toFeatureWeights(weights))(state);
+}
+int MCTS::cardCost(const PlayerInfo& player, const PlayerInfo& opponent, const CardInfo& card) {
+    const bool hasCost = std::any_of(card.resourceCost.begin(), card.resourceCost.end(), [](uint8_t amount) { return amount > 0; });
+    if (!hasCost) return 0;
+    if (card.requiredLinkingSymbol != Models::LinkingSymbolType::NO_SYMBOL && player.hasLinkingSymbol(card.requiredLinkingSymbol)) return 0;
+    int cost = card.coinCost;
+    for (size_t res = 0; res < ResourceSlots; ++res) {
+        const int produced = player.permanentResources[res] + player.tradingResources[res];
+        if (produced >= card.resourceCost[res]) continue;
+        cost += (card.resourceCost[res] - produced) * (2 + opponent.permanentResources[res]);
+    }
+    if (card.color == Models::ColorType::BLUE && player.hasProgressToken(static_cast<size_t>(Models::TokenIndex::MASONRY)) && cost >= 2) {
+        cost -= 2;
+    }
+    return cost;
+}
+int MCTS::wonderCost(const PlayerInfo& player, const PlayerInfo& opponent, const CardInfo& wonder) {
+    std::array<uint8_t, 32> unitPrices{};
+    size_t units = 0;
+    for (size_t res = 0; res < ResourceSlots; ++res) {
+        const int produced = player.permanentResources[res] + player.tradingResources[res];
+        const uint8_t price = player.hasFixedPrice(res) ? 1 : static_cast<uint8_t>(2 + opponent.brownGreyProduction[res]);
+        for (int missing = wonder.resourceCost[res] - produced; missing > 0 && units < unitPrices.size(); --missing) {
+            unitPrices[units++] = price;
+        }
+    }
+    const auto end = unitPrices.begin() + static_cast<std::ptrdiff_t>(units);
+    std::sort(unitPrices.begin(), end, std::greater<>());
+    const size_t free = player.hasProgressToken(static_cast<size_t>(Models::TokenIndex::ARCHITECTURE)) ? std::min<size_t>(2, units) : 0;
+    int cost = 0;
+    for (size_t i = free; i < units; ++i) cost += unitPrices[i];
+    return cost;
+}
+double MCTS::evaluateResourceDenial(const MCTSGameState& state, const MCTSAction& action) {
     const PlayerInfo& opponent = state.getOpponent();
     double denialValue = 0.0;
     if (opponent.brownCards < 2 || opponent.greyCards < 2) {
@@ -536,25 +1755,35 @@ double MCTS::evaluateResourceDenial(const MCTSGameState& state, const MCTSAction
     }
     return denialValue;
 }
-double MCTS::evaluateScientificProgress(const PlayerInfo& player) const {
-    double scienceValue = 0.0;
-    size_t symbolTypes = 0;
-    for (const auto& [symbol, count] : player.scientificSymbols) {
-        if (count > 0) symbolTypes++;
+double MCTS::actionPrior(const MCTSGameState& state, const MCTSAction& action) {
+    const PlayerInfo& player = state.getCurrentPlayer();
+    const CardInfo& card = MCTSCardCatalog::get(action.cardId);
+    double prior = evaluateResourceDenial(state, action);
+    if (action.actionType == 1) {
+        return prior + 0.5 + 0.25 * player.yellowCards;
     }
-    if (symbolTypes >= 6) {
-        return 1000.0; 
+    prior += action.expectedVP;
+    if (action.actionType == 2) {
+        const CardInfo& wonder = MCTSCardCatalog::get(player.wonderIds[action.wonderIndex]);
+        return prior + 1.5 + wonder.shieldPoints;
     }
-    scienceValue = symbolTypes * 5.0;
-    return scienceValue;
-}
-double MCTS::evaluateMilitaryPosition(int position, bool forPlayer1) const {
-    if (position <= 0) return forPlayer1 ? 1000.0 : -1000.0; 
-    if (position >= 18) return forPlayer1 ? -1000.0 : 1000.0; 
-    if (forPlayer1) {
-        return (18 - position) * 0.5; 
-    } else {
-        return position * 0.5; 
+    switch (action.cardColor) {
+        case Models::ColorType::GREEN:
+            if (card.hasScientificSymbol && !player.hasScientificSymbol(card.scientificSymbol)) prior += 1.0 + 0.5 * player.scientificSymbolCount();
+            break;
+        case Models::ColorType::RED:
+            prior += shieldPrior(card.shieldPoints, state.militaryPosition, state.player1Turn);
+            break;
+        case Models::ColorType::BROWN:
+        case Models::ColorType::GREY:
+            for (uint8_t quantity : card.resourcesProduction) prior += quantity * (4 - state.currentPhase) * 0.5;
+            break;
+        case Models::ColorType::YELLOW:
+            prior += 0.5;
+            break;
+        default:
+            break;
     }
+    return prior + 1.0;
 }
 } 
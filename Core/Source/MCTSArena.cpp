@@ -0,0 +1,46 @@
+module Core.MCTSArena;
+import <cstddef>;
+import <cstdint>;
+import <memory>;
+import <algorithm>;
+using namespace Core;
+MCTSArena::MCTSArena(size_t blockSize)
+    : m_blockSize(blockSize)
+{
+}
+MCTSArena::~MCTSArena() {
+    reset();
+}
+void* MCTSArena::allocate(size_t bytes, size_t alignment) {
+    while (m_currentBlock < m_blocks.size()) {
+        Block& block = m_blocks[m_currentBlock];
+        const auto base = reinterpret_cast<uintptr_t>(block.memory.get());
+        const uintptr_t aligned = (base + m_offset + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+        const size_t end = static_cast<size_t>(aligned - base) + bytes;
+        if (end <= block.size) {
+            m_offset = end;
+            m_allocatedBytes += bytes;
+            return reinterpret_cast<void*>(aligned);
+        }
+        ++m_currentBlock;
+        m_offset = 0;
+    }
+    Block block;
+    block.size = std::max(m_blockSize, bytes + alignment);
+    block.memory = std::make_unique_for_overwrite<std::byte[]>(block.size);
+    m_reservedBytes += block.size;
+    m_blocks.push_back(std::move(block));
+    m_currentBlock = m_blocks.size() - 1;
+    m_offset = 0;
+    return allocate(bytes, alignment);
+}
+void MCTSArena::reset() {
+    for (auto it = m_destructors.rbegin(); it != m_destructors.rend(); ++it) {
+        it->destroy(it->object);
+    }
+    m_destructors.clear();
+    m_currentBlock = 0;
+    m_offset = 0;
+    m_objectCount = 0;
+    m_allocatedBytes = 0;
+}
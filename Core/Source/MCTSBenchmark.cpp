@@ -0,0 +1,195 @@
+module Core.MCTSBenchmark;
+import <vector>;
+import <chrono>;
+import <iostream>;
+import <iomanip>;
+import <memory>;
+import <random>;
+import Core.AIConfig;
+import Core.MCTS;
+import Core.PlayerDecisionMaker;
+import Core.Game;
+import Core.GameState;
+import Models.Player;
+namespace Core {
+namespace {
+    constexpr uint32_t BenchmarkSeed = 7;
+    constexpr int BenchmarkIterations = 8000;
+    const std::vector<int> BenchmarkThreadCounts{ 1, 2, 4, 8, 16 };
+    constexpr int BenchmarkClones = 200000;
+    constexpr int BenchmarkRollouts = 20000;
+    constexpr int BenchmarkMidgamePlies = 30;
+    constexpr int BenchmarkPlayoutGames = 20;
+    constexpr std::chrono::milliseconds BenchmarkMoveTime{ 20 };
+    double elapsedMs(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+StateThroughput measureStateThroughput(const MCTSGameState& rootState, int clones, int rollouts) {
+    StateThroughput throughput;
+    MCTSGameState source = MCTS::cloneState(rootState);
+    if (source.availableActions.empty()) {
+        source.availableActions = MCTS::getLegalActions(source, source.currentPhase);
+    }
+    std::mt19937 rng(BenchmarkSeed);
+    MCTSGameState midgame = MCTS::cloneState(source);
+    for (int ply = 0; ply < BenchmarkMidgamePlies && !MCTS::isTerminal(midgame); ++ply) {
+        auto actions = MCTS::getLegalActions(midgame, midgame.currentPhase);
+        if (actions.empty()) break;
+        std::uniform_int_distribution<size_t> dist(0, actions.size() - 1);
+        MCTS::applyAction(midgame, actions[dist(rng)]);
+    }
+    midgame.availableActions = MCTS::getLegalActions(midgame, midgame.currentPhase);
+    int checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < clones; ++i) {
+        MCTSGameState copy = MCTS::cloneState(midgame);
+        checksum += copy.roundsRemaining;
+    }
+    double ms = elapsedMs(start);
+    throughput.clonesPerSecond = ms > 0.0 && checksum != 0 ? clones * 1000.0 / ms : 0.0;
+    long long plies = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rollouts; ++i) {
+        MCTSGameState state = MCTS::cloneState(source);
+        while (!MCTS::isTerminal(state)) {
+            auto actions = MCTS::getLegalActions(state, state.currentPhase);
+            if (actions.empty()) break;
+            std::uniform_int_distribution<size_t> dist(0, actions.size() - 1);
+            MCTS::applyAction(state, actions[dist(rng)]);
+            ++plies;
+        }
+    }
+    ms = elapsedMs(start);
+    throughput.rolloutsPerSecond = ms > 0.0 ? rollouts * 1000.0 / ms : 0.0;
+    throughput.averageRolloutLength = rollouts > 0 ? static_cast<double>(plies) / rollouts : 0.0;
+    return throughput;
+}
+PlayoutMatch measurePlayoutPolicy(const MCTSGameState& rootState, const PlayoutSettings& candidate, int games,
+                                  std::chrono::milliseconds moveTime) {
+    PlayoutMatch match;
+    match.policy = candidate.policy;
+    PlayoutSettings baseline;
+    baseline.policy = PlayoutPolicy::RANDOM;
+    long long candidateIterations = 0, baselineIterations = 0;
+    int candidateMoveCount = 0, baselineMoveCount = 0;
+    std::streambuf* previous = std::cout.rdbuf(nullptr);
+    for (int game = 0; game < games; ++game) {
+        const bool candidateIsPlayer1 = game % 2 == 0;
+        MCTS candidateSearch(1000, 1.414, 50, Playstyle::BRITNEY, 1);
+        MCTS baselineSearch(1000, 1.414, 50, Playstyle::BRITNEY, 1);
+        candidateSearch.setPlayout(candidate);
+        baselineSearch.setPlayout(baseline);
+        candidateSearch.setSeed(BenchmarkSeed + game);
+        baselineSearch.setSeed(BenchmarkSeed + game);
+        MCTSGameState state = MCTS::cloneState(rootState);
+        while (!MCTS::isTerminal(state)) {
+            state.availableActions = MCTS::getLegalActions(state, state.currentPhase);
+            if (state.availableActions.empty()) break;
+            const bool candidateMoves = state.player1Turn == candidateIsPlayer1;
+            MCTS& search = candidateMoves ? candidateSearch : baselineSearch;
+            MCTSAction action = search.searchFor(state, moveTime);
+            (candidateMoves ? candidateIterations : baselineIterations) += search.getLastIterations();
+            ++(candidateMoves ? candidateMoveCount : baselineMoveCount);
+            MCTS::applyAction(state, action);
+        }
+        const int winner = MCTS::getWinner(state);
+        ++match.games;
+        if (winner != 0 && winner != 1) ++match.draws;
+        else if ((winner == 0) == candidateIsPlayer1) ++match.wins;
+        else ++match.losses;
+    }
+    std::cout.rdbuf(previous);
+    match.candidateIterationsPerMove = candidateMoveCount > 0 ? static_cast<double>(candidateIterations) / candidateMoveCount : 0.0;
+    match.baselineIterationsPerMove = baselineMoveCount > 0 ? static_cast<double>(baselineIterations) / baselineMoveCount : 0.0;
+    return match;
+}
+void printPlayoutReport(std::chrono::milliseconds moveTime, const std::vector<PlayoutMatch>& matches) {
+    std::cout << "\n=== MCTS playout policy vs random (" << moveTime.count() << " ms/move) ===\n";
+    std::cout << std::setw(16) << "policy" << std::setw(8) << "games" << std::setw(8) << "wins" << std::setw(8) << "draws"
+              << std::setw(8) << "losses" << std::setw(10) << "win rate" << std::setw(12) << "it/move" << std::setw(16) << "random it/move" << "\n";
+    for (const auto& match : matches) {
+        const char* name = match.policy == PlayoutPolicy::SOFTMAX ? "softmax"
+                         : match.policy == PlayoutPolicy::EPSILON_GREEDY ? "epsilon-greedy" : "random";
+        const double winRate = match.games > 0 ? (match.wins + 0.5 * match.draws) * 100.0 / match.games : 0.0;
+        std::cout << std::setw(16) << name << std::setw(8) << match.games << std::setw(8) << match.wins
+                  << std::setw(8) << match.draws << std::setw(8) << match.losses
+                  << std::setw(9) << std::fixed << std::setprecision(1) << winRate << "%"
+                  << std::setw(12) << std::setprecision(0) << match.candidateIterationsPerMove
+                  << std::setw(16) << match.baselineIterationsPerMove << "\n";
+    }
+}
+void printThroughputReport(const StateThroughput& throughput) {
+    std::cout << "\n=== MCTS state throughput ===\n"
+              << std::fixed << std::setprecision(0)
+              << "clones/sec:   " << throughput.clonesPerSecond << "\n"
+              << "rollouts/sec: " << throughput.rolloutsPerSecond << "\n"
+              << std::setprecision(1)
+              << "plies/rollout: " << throughput.averageRolloutLength << "\n";
+}
+std::vector<ScalingSample> measureSearchScaling(const MCTSGameState& rootState, SearchParallelism mode,
+                                                int totalIterations, const std::vector<int>& threadCounts) {
+    std::vector<ScalingSample> samples;
+    double baselineRate = 0.0;
+    for (int threads : threadCounts) {
+        MCTS mcts(totalIterations / threads, 1.414, 50, Playstyle::BRITNEY, threads);
+        mcts.setParallelism(mode);
+        mcts.setSeed(BenchmarkSeed);
+        auto start = std::chrono::steady_clock::now();
+        std::streambuf* previous = std::cout.rdbuf(nullptr);
+        mcts.search(rootState);
+        std::cout.rdbuf(previous);
+        ScalingSample sample;
+        sample.threads = threads;
+        sample.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        sample.iterationsPerSecond = sample.milliseconds > 0.0 ? mcts.getLastIterations() * 1000.0 / sample.milliseconds : 0.0;
+        if (samples.empty()) baselineRate = sample.iterationsPerSecond / threads;
+        sample.efficiency = baselineRate > 0.0 ? sample.iterationsPerSecond / (threads * baselineRate) : 0.0;
+        sample.nodes = mcts.getNodeCount();
+        sample.arenaBytes = mcts.getArenaBytes();
+        samples.push_back(sample);
+    }
+    return samples;
+}
+void printScalingReport(SearchParallelism mode, const std::vector<ScalingSample>& samples) {
+    std::cout << "\n=== MCTS scaling (" << (mode == SearchParallelism::TREE ? "tree-parallel" : "root-parallel") << ") ===\n";
+    std::cout << std::setw(8) << "threads" << std::setw(12) << "ms" << std::setw(14) << "it/s"
+              << std::setw(12) << "efficiency" << std::setw(10) << "nodes" << std::setw(12) << "bytes/node" << "\n";
+    for (const auto& sample : samples) {
+        std::cout << std::setw(8) << sample.threads
+                  << std::setw(12) << std::fixed << std::setprecision(1) << sample.milliseconds
+                  << std::setw(14) << std::setprecision(0) << sample.iterationsPerSecond
+                  << std::setw(11) << std::setprecision(1) << sample.efficiency * 100.0 << "%"
+                  << std::setw(10) << sample.nodes
+                  << std::setw(12) << (sample.nodes > 0 ? sample.arenaBytes / sample.nodes : 0) << "\n";
+    }
+}
+bool printTreeParallelCheck(int threads) {
+    const AIConfig config(Playstyle::BRITNEY, 1.414, 1000, 20, threads, SearchParallelism::TREE);
+    const bool shared = MCTSDecisionMaker::create(config, SelectionRule::UCB1)->usesSharedTree();
+    std::cout << "\n=== MCTS tree-parallel config (" << threads << " threads) ===\n"
+              << (shared ? "shared tree" : "FAILED: search falls back to separate trees") << "\n";
+    return shared;
+}
+void runMCTSBenchmarks() {
+    auto& gameState = GameState::getInstance();
+    if (!gameState.GetPlayer1()->m_player) gameState.GetPlayer1()->m_player = std::make_unique<Models::Player>(1, "Benchmark1");
+    if (!gameState.GetPlayer2()->m_player) gameState.GetPlayer2()->m_player = std::make_unique<Models::Player>(2, "Benchmark2");
+    std::streambuf* previous = std::cout.rdbuf(nullptr);
+    Game::preparation();
+    std::cout.rdbuf(previous);
+    MCTSGameState rootState = MCTS::captureGameState(1, true);
+    printThroughputReport(measureStateThroughput(rootState, BenchmarkClones, BenchmarkRollouts));
+    printTreeParallelCheck(4);
+    for (SearchParallelism mode : { SearchParallelism::ROOT, SearchParallelism::TREE }) {
+        printScalingReport(mode, measureSearchScaling(rootState, mode, BenchmarkIterations, BenchmarkThreadCounts));
+    }
+    std::vector<PlayoutMatch> matches;
+    for (PlayoutPolicy policy : { PlayoutPolicy::EPSILON_GREEDY, PlayoutPolicy::SOFTMAX }) {
+        PlayoutSettings candidate;
+        candidate.policy = policy;
+        matches.push_back(measurePlayoutPolicy(rootState, candidate, BenchmarkPlayoutGames, BenchmarkMoveTime));
+    }
+    printPlayoutReport(BenchmarkMoveTime, matches);
+}
+}
@@ -0,0 +1,67 @@
+#include <cmath>
+#include <limits>
+#include <numbers>
+module Core.MCTSPolicies;
+import <algorithm>;
+import <atomic>;
+import <bit>;
+import <random>;
+import <cstdint>;
+import Core.MCTS;
+using namespace Core;
+namespace {
+    int childVisits(const ChildStatistics& stats, size_t i) {
+        return std::atomic_ref<int32_t>(stats.visits[i]).load(std::memory_order_relaxed) +
+               std::atomic_ref<int32_t>(stats.pending[i]).load(std::memory_order_relaxed);
+    }
+    double childValue(const ChildStatistics& stats, size_t i) {
+        return std::atomic_ref<double>(stats.values[i]).load(std::memory_order_relaxed);
+    }
+}
+void UCB1::score(const ChildStatistics& stats, size_t count, double explorationConstant, int parentVisits, double* scores) {
+    const double logParent = parentVisits > 0 ? std::log(static_cast<double>(parentVisits)) : 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        const int visits = childVisits(stats, i);
+        if (visits <= 0) {
+            scores[i] = std::numeric_limits<double>::infinity();
+            continue;
+        }
+        const double n = static_cast<double>(visits);
+        scores[i] = childValue(stats, i) / n + explorationConstant * std::sqrt(logParent / n);
+    }
+}
+void UCB1Tuned::score(const ChildStatistics& stats, size_t count, double explorationConstant, int parentVisits, double* scores) {
+    const double logParent = parentVisits > 0 ? std::log(static_cast<double>(parentVisits)) : 0.0;
+    const double scale = explorationConstant / std::numbers::sqrt2;
+    for (size_t i = 0; i < count; ++i) {
+        const int visits = childVisits(stats, i);
+        if (visits <= 0) {
+            scores[i] = std::numeric_limits<double>::infinity();
+            continue;
+        }
+        const double n = static_cast<double>(visits);
+        const double mean = childValue(stats, i) / n;
+        const double variance = std::max(std::atomic_ref<double>(stats.squares[i]).load(std::memory_order_relaxed) / n - mean * mean, 0.0);
+        const double bound = std::min(0.25, variance + std::sqrt(2.0 * logParent / n));
+        scores[i] = mean + scale * std::sqrt(logParent / n * bound);
+    }
+}
+void PUCT::score(const ChildStatistics& stats, size_t count, double explorationConstant, int parentVisits, double* scores) {
+    const double rootParent = std::sqrt(static_cast<double>(std::max(parentVisits, 1)));
+    for (size_t i = 0; i < count; ++i) {
+        const int visits = childVisits(stats, i);
+        const double mean = visits > 0 ? childValue(stats, i) / visits : FirstPlayValue;
+        scores[i] = mean + explorationConstant * stats.priors[i] * rootParent / (1.0 + std::max(visits, 0));
+    }
+}
+size_t SequentialHalving::rounds(size_t candidates) {
+    return candidates > 1 ? static_cast<size_t>(std::bit_width(candidates - 1)) : 1;
+}
+double SequentialHalving::gumbel(std::mt19937& rng) {
+    const double uniform = std::uniform_real_distribution<double>(std::numeric_limits<double>::min(), 1.0)(rng);
+    return -std::log(-std::log(uniform));
+}
+double SequentialHalving::score(double gumbel, double prior, double meanValue, int maxVisits) {
+    const double logit = std::log(std::max(prior, std::numeric_limits<double>::min()));
+    return gumbel + logit + (VisitOffset + maxVisits) * ValueScale * meanValue;
+}
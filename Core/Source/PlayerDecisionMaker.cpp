@@ -3,6 +3,7 @@ import <vector>;
 import <iostream>;
 import <memory>;
 import <random>;
+import <chrono>;
 import <algorithm>;
 import <iomanip>;
 import Core.MCTS;
@@ -11,6 +12,7 @@ import Core.Board;
 import Core.GameState;
 import Core.Node;
 import Core.AIConfig;
+import Core.ThinkTimeManager;
 import Models.Card;
 import Models.AgeCard;
 import Models.Wonder;
@@ -117,15 +119,31 @@ std::uint8_t HumanDecisionMaker::selectStartingPlayer() {
     std::cin >> choice;
     return (choice == 0) ? 0 : 1;
 }
-MCTSDecisionMaker::MCTSDecisionMaker(Playstyle playstyle, int iterations, double explorationConstant, int maxDepth)
+MCTSDecisionMaker::MCTSDecisionMaker(Playstyle playstyle, int iterations, double explorationConstant, int maxDepth, int threadCount)
     : m_playstyle(playstyle)
     , m_iterations(iterations)
     , m_explorationConstant(explorationConstant)
     , m_maxDepth(maxDepth)
+    , m_threadCount(threadCount)
 {
-    m_mcts = std::make_unique<MCTS>(iterations, explorationConstant, maxDepth, playstyle);
+    m_mcts = std::make_unique<MCTS>(iterations, explorationConstant, maxDepth, playstyle, threadCount);
+    m_mcts->setTreeReuse(true);
+    m_mcts->setDeterminizations(MCTS::DeterminizationPerThread);
+}
+MCTSDecisionMaker::MCTSDecisionMaker(const AIConfig& config)
+    : MCTSDecisionMaker(config.getPlaystyle(), config.getMCTSIterations(), config.getExplorationConstant(),
+                        config.getMaxSimulationDepth(), config.getSearchThreads())
+{
+    setParallelism(config.getParallelism());
 }
 MCTSDecisionMaker::~MCTSDecisionMaker() = default;
+std::unique_ptr<MCTSDecisionMaker> MCTSDecisionMaker::create(const AIConfig& config, SelectionRule selection,
+                                                             PlayoutPolicy playout, EvaluatorKind evaluator) {
+    auto decisionMaker = std::make_unique<MCTSDecisionMaker>(config);
+    decisionMaker->setSearchPolicy(SearchPolicy{ selection, evaluator });
+    decisionMaker->setPlayoutPolicy(playout);
+    return decisionMaker;
+}
 void MCTSDecisionMaker::setPlaystyle(Playstyle style) {
     m_playstyle = style;
     m_mcts->setPlaystyle(style);
@@ -142,9 +160,66 @@ void MCTSDecisionMaker::setMaxDepth(int depth) {
     m_maxDepth = depth;
     m_mcts->setMaxDepth(depth);
 }
+void MCTSDecisionMaker::setThreadCount(int threads) {
+    m_threadCount = threads;
+    m_mcts->setThreadCount(threads);
+}
+void MCTSDecisionMaker::setSeed(uint32_t seed) {
+    m_mcts->setSeed(seed);
+}
+void MCTSDecisionMaker::setParallelism(SearchParallelism mode) {
+    m_mcts->setParallelism(mode);
+    m_mcts->setDeterminizations(mode == SearchParallelism::TREE ? 0 : MCTS::DeterminizationPerThread);
+}
+void MCTSDecisionMaker::setTreeReuse(bool enabled) {
+    m_mcts->setTreeReuse(enabled);
+    if (!enabled) m_pondering = false;
+}
+void MCTSDecisionMaker::setTimeBudget(std::chrono::milliseconds budget) {
+    m_timeBudget = budget;
+}
+void MCTSDecisionMaker::setGameTimeBudget(std::chrono::milliseconds budget) {
+    ThinkTimeSettings settings = m_thinkTime.getSettings();
+    settings.gameBudget = budget;
+    m_thinkTime = ThinkTimeManager(settings);
+}
+void MCTSDecisionMaker::startGame() {
+    m_thinkTime.startGame();
+}
+void MCTSDecisionMaker::setPositionCache(std::shared_ptr<PositionCache> cache) {
+    m_mcts->setPositionCache(std::move(cache));
+}
+void MCTSDecisionMaker::setPondering(bool enabled) {
+    m_pondering = enabled;
+    if (enabled) m_mcts->setTreeReuse(true);
+    else m_mcts->stopPondering();
+}
+void MCTSDecisionMaker::setSearchPolicy(const SearchPolicy& policy) {
+    m_mcts->setSearchPolicy(policy);
+}
+void MCTSDecisionMaker::setPlayoutPolicy(PlayoutPolicy policy) {
+    PlayoutSettings playout = m_mcts->getPlayout();
+    playout.policy = policy;
+    m_mcts->setPlayout(playout);
+}
+bool MCTSDecisionMaker::getPondering() const {
+    return m_pondering;
+}
 Playstyle MCTSDecisionMaker::getPlaystyle() const {
     return m_playstyle;
 }
+int MCTSDecisionMaker::getThreadCount() const {
+    return m_threadCount;
+}
+bool MCTSDecisionMaker::usesSharedTree() const {
+    return m_mcts->usesSharedTree();
+}
+const SearchStats& MCTSDecisionMaker::getLastSearchStats() const {
+    return m_lastStats;
+}
+const ThinkTimeManager& MCTSDecisionMaker::getThinkTimeManager() const {
+    return m_thinkTime;
+}
 MCTSAction MCTSDecisionMaker::selectTurnAction() {
     auto& gs = GameState::getInstance();
     const int phase = gs.getCurrentPhase();
@@ -152,15 +227,36 @@ MCTSAction MCTSDecisionMaker::selectTurnAction() {
 
     
     if (m_mcts) {
+        m_mcts->stopPondering();
         m_mcts->setIterations(m_iterations);
         m_mcts->setExplorationConstant(m_explorationConstant);
         m_mcts->setMaxDepth(m_maxDepth);
         m_mcts->setPlaystyle(m_playstyle);
+        m_mcts->setThreadCount(m_threadCount);
     }
 
+    const auto moveStart = std::chrono::steady_clock::now();
+    auto spentSince = [](std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    };
     MCTSGameState state = MCTS::captureGameState(phase, isP1Turn);
     if (!m_mcts) return MCTSAction{};
-    return m_mcts->search(state);
+    m_mcts->setUnseenCards(MCTS::captureUnseenCards());
+    std::chrono::milliseconds budget = m_timeBudget;
+    if (m_thinkTime.isEnabled()) {
+        state.availableActions = MCTS::getLegalActions(state, state.currentPhase);
+        if (m_thinkTime.isForced(state)) {
+            m_lastStats = SearchStats{};
+            m_thinkTime.record(spentSince(moveStart), m_lastStats);
+            return state.availableActions.empty() ? MCTSAction{} : state.availableActions[0];
+        }
+        budget = m_thinkTime.allocate(state);
+    }
+    const MCTSAction action = budget.count() > 0 ? m_mcts->searchFor(state, budget) : m_mcts->search(state);
+    m_lastStats = m_mcts->getLastSearchStats();
+    if (m_thinkTime.isEnabled()) m_thinkTime.record(spentSince(moveStart), m_lastStats);
+    if (m_pondering) m_mcts->startPondering();
+    return action;
 }
 size_t MCTSDecisionMaker::selectCard(const std::vector<size_t>& available) {
     if (available.empty()) return 0;
@@ -429,6 +525,10 @@ HumanAssistedDecisionMaker::HumanAssistedDecisionMaker(Playstyle suggestionStyle
     , m_iterations(iterations)
 {
     m_mcts = std::make_unique<MCTS>(iterations, 1.414, 20, suggestionStyle);
+    m_mcts->setDeterminizations(MCTS::DeterminizationPerThread);
+    SearchPolicy policy;
+    policy.root = RootPolicy::SEQUENTIAL_HALVING;
+    m_mcts->setSearchPolicy(policy);
 }
 HumanAssistedDecisionMaker::~HumanAssistedDecisionMaker() = default;
 void HumanAssistedDecisionMaker::setSuggestionStyle(Playstyle style) {
@@ -440,6 +540,7 @@ Playstyle HumanAssistedDecisionMaker::getSuggestionStyle() const {
 }
 void HumanAssistedDecisionMaker::showSuggestions(const std::vector<size_t>& options, const std::string& context) {
     if (options.empty()) return;
+    m_mcts->setUnseenCards(MCTS::captureUnseenCards());
     
     auto& notifier = GameState::getInstance().getEventNotifier();
     DisplayRequestEvent event;
@@ -638,6 +739,7 @@ std::uint8_t HumanAssistedDecisionMaker::selectStartingPlayer() {
 }
 AIDecisionMaker::AIDecisionMaker() {
     m_mcts = std::make_unique<MCTS>(m_simulationCount, m_explorationConstant, m_maxDepth);
+    m_mcts->setDeterminizations(MCTS::DeterminizationPerThread);
 }
 AIDecisionMaker::~AIDecisionMaker() = default;
 void AIDecisionMaker::setSimulationCount(unsigned int count) {
@@ -652,6 +754,9 @@ void AIDecisionMaker::setMaxDepth(unsigned int depth) {
     m_maxDepth = depth;
     m_mcts->setMaxDepth(static_cast<int>(depth));
 }
+const SearchStats& AIDecisionMaker::getLastSearchStats() const {
+    return m_mcts->getLastSearchStats();
+}
 MCTSAction AIDecisionMaker::selectTurnAction() {
     auto& gs = GameState::getInstance();
     const int phase = gs.getCurrentPhase();
@@ -665,6 +770,7 @@ MCTSAction AIDecisionMaker::selectTurnAction() {
 
     MCTSGameState state = MCTS::captureGameState(phase, isP1Turn);
     if (!m_mcts) return MCTSAction{};
+    m_mcts->setUnseenCards(MCTS::captureUnseenCards());
     return m_mcts->search(state);
 }
 size_t AIDecisionMaker::selectCard(const std::vector<size_t>& available) {
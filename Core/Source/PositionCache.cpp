@@ -0,0 +1,251 @@
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+module Core.PositionCache;
+import Core.FileLock;
+import <algorithm>;
+import <atomic>;
+import <cstddef>;
+import <cstdint>;
+import <iostream>;
+import <mutex>;
+import <optional>;
+import <string>;
+import <type_traits>;
+import <utility>;
+using namespace Core;
+namespace {
+    constexpr uint64_t CacheMagic = 0x3757504F53434143ull;
+    constexpr uint32_t CacheVersion = 1;
+    struct CacheHeader {
+        uint64_t magic = 0;
+        uint32_t version = 0;
+        uint32_t ways = 0;
+        uint64_t buckets = 0;
+        uint64_t clock = 0;
+    };
+    struct CacheSlot {
+        uint64_t key = 0;
+        uint64_t lastUsed = 0;
+        CachedRoot root;
+    };
+    static_assert(std::is_trivially_copyable_v<CacheSlot>);
+    class RangeLock {
+    public:
+        RangeLock(std::intptr_t file, size_t offset, size_t length, bool exclusive)
+            : m_file(file), m_offset(offset), m_length(length)
+        {
+#if defined(_WIN32)
+            OVERLAPPED overlapped{};
+            overlapped.Offset = static_cast<DWORD>(offset);
+            overlapped.OffsetHigh = static_cast<DWORD>(static_cast<uint64_t>(offset) >> 32);
+            LockFileEx(reinterpret_cast<HANDLE>(file), exclusive ? LOCKFILE_EXCLUSIVE_LOCK : 0, 0,
+                       static_cast<DWORD>(length), static_cast<DWORD>(static_cast<uint64_t>(length) >> 32), &overlapped);
+#else
+            struct flock lock{};
+            lock.l_type = exclusive ? F_WRLCK : F_RDLCK;
+            lock.l_whence = SEEK_SET;
+            lock.l_start = static_cast<off_t>(offset);
+            lock.l_len = static_cast<off_t>(length);
+            while (fcntl(static_cast<int>(file), F_SETLKW, &lock) == -1 && errno == EINTR) {}
+#endif
+        }
+        ~RangeLock() {
+#if defined(_WIN32)
+            OVERLAPPED overlapped{};
+            overlapped.Offset = static_cast<DWORD>(m_offset);
+            overlapped.OffsetHigh = static_cast<DWORD>(static_cast<uint64_t>(m_offset) >> 32);
+            UnlockFileEx(reinterpret_cast<HANDLE>(m_file), 0, static_cast<DWORD>(m_length),
+                         static_cast<DWORD>(static_cast<uint64_t>(m_length) >> 32), &overlapped);
+#else
+            struct flock lock{};
+            lock.l_type = F_UNLCK;
+            lock.l_whence = SEEK_SET;
+            lock.l_start = static_cast<off_t>(m_offset);
+            lock.l_len = static_cast<off_t>(m_length);
+            fcntl(static_cast<int>(m_file), F_SETLK, &lock);
+#endif
+        }
+        RangeLock(const RangeLock&) = delete;
+        RangeLock& operator=(const RangeLock&) = delete;
+    private:
+        std::intptr_t m_file;
+        size_t m_offset;
+        size_t m_length;
+    };
+    CacheHeader readHeader(std::intptr_t file) {
+        CacheHeader header;
+#if defined(_WIN32)
+        OVERLAPPED overlapped{};
+        DWORD read = 0;
+        ReadFile(reinterpret_cast<HANDLE>(file), &header, sizeof(header), &read, &overlapped);
+#else
+        if (pread(static_cast<int>(file), &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))) header = CacheHeader{};
+#endif
+        return header;
+    }
+    std::intptr_t openFile(const std::string& path) {
+#if defined(_WIN32)
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                  nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        return file == INVALID_HANDLE_VALUE ? -1 : reinterpret_cast<std::intptr_t>(file);
+#else
+        return open(path.c_str(), O_RDWR);
+#endif
+    }
+    void closeFile(std::intptr_t file) {
+#if defined(_WIN32)
+        CloseHandle(reinterpret_cast<HANDLE>(file));
+#else
+        close(static_cast<int>(file));
+#endif
+    }
+    bool sameLayout(const CacheHeader& existing, const CacheHeader& expected) {
+        return existing.magic == expected.magic && existing.version == expected.version &&
+               existing.ways == expected.ways && existing.buckets == expected.buckets;
+    }
+    bool replaceFile(const std::string& path, size_t bytes, const CacheHeader& header) {
+        const std::string temporary = path + ".tmp";
+#if defined(_WIN32)
+        HANDLE handle = CreateFileA(temporary.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (handle == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER position{};
+        position.QuadPart = static_cast<LONGLONG>(bytes);
+        DWORD written = 0;
+        OVERLAPPED overlapped{};
+        const bool writtenOk = SetFilePointerEx(handle, position, nullptr, FILE_BEGIN) && SetEndOfFile(handle) &&
+                                WriteFile(handle, &header, sizeof(header), &written, &overlapped) && written == sizeof(header);
+        CloseHandle(handle);
+        if (!writtenOk) {
+            DeleteFileA(temporary.c_str());
+            return false;
+        }
+        return MoveFileExA(temporary.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+        const int descriptor = open(temporary.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (descriptor < 0) return false;
+        const bool writtenOk = ftruncate(descriptor, static_cast<off_t>(bytes)) == 0 &&
+                               pwrite(descriptor, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header));
+        close(descriptor);
+        if (!writtenOk) {
+            unlink(temporary.c_str());
+            return false;
+        }
+        return rename(temporary.c_str(), path.c_str()) == 0;
+#endif
+    }
+    CacheHeader& headerOf(std::byte* view) { return *reinterpret_cast<CacheHeader*>(view); }
+    CacheSlot* slotsAt(std::byte* view, size_t offset) { return reinterpret_cast<CacheSlot*>(view + offset); }
+}
+PositionCache::PositionCache(PositionCacheSettings settings)
+    : m_settings(std::move(settings))
+{
+    m_settings.ways = std::max<size_t>(m_settings.ways, 1);
+    m_buckets = std::max<size_t>(m_settings.capacity / m_settings.ways, 1);
+    m_bytes = sizeof(CacheHeader) + m_buckets * m_settings.ways * sizeof(CacheSlot);
+    CacheHeader header;
+    header.magic = CacheMagic;
+    header.version = CacheVersion;
+    header.ways = static_cast<uint32_t>(m_settings.ways);
+    header.buckets = m_buckets;
+    {
+        FileLock lock(m_settings.path + ".lock");
+        m_file = openFile(m_settings.path);
+        if (m_file != -1 && !sameLayout(readHeader(m_file), header)) {
+            closeFile(m_file);
+            m_file = -1;
+        }
+        if (m_file == -1) {
+            if (!replaceFile(m_settings.path, m_bytes, header)) {
+                std::cerr << "[PositionCache] Cannot initialise " << m_settings.path << "\n";
+                return;
+            }
+            m_file = openFile(m_settings.path);
+        }
+    }
+    if (m_file == -1) {
+        std::cerr << "[PositionCache] Cannot open " << m_settings.path << "\n";
+        return;
+    }
+#if defined(_WIN32)
+    HANDLE mapping = CreateFileMappingA(reinterpret_cast<HANDLE>(m_file), nullptr, PAGE_READWRITE,
+                                        static_cast<DWORD>(static_cast<uint64_t>(m_bytes) >> 32),
+                                        static_cast<DWORD>(m_bytes), nullptr);
+    if (mapping == nullptr) return;
+    m_mapping = reinterpret_cast<std::intptr_t>(mapping);
+    m_view = static_cast<std::byte*>(MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, m_bytes));
+#else
+    void* view = mmap(nullptr, m_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, static_cast<int>(m_file), 0);
+    m_view = view == MAP_FAILED ? nullptr : static_cast<std::byte*>(view);
+#endif
+}
+PositionCache::~PositionCache() {
+#if defined(_WIN32)
+    if (m_view) {
+        FlushViewOfFile(m_view, 0);
+        UnmapViewOfFile(m_view);
+    }
+    if (m_mapping) CloseHandle(reinterpret_cast<HANDLE>(m_mapping));
+    if (m_file != -1) CloseHandle(reinterpret_cast<HANDLE>(m_file));
+#else
+    if (m_view) munmap(m_view, m_bytes);
+    if (m_file >= 0) close(static_cast<int>(m_file));
+#endif
+}
+size_t PositionCache::bucketOffset(uint64_t key) const {
+    return sizeof(CacheHeader) + static_cast<size_t>(key % m_buckets) * m_settings.ways * sizeof(CacheSlot);
+}
+std::optional<CachedRoot> PositionCache::lookup(uint64_t key) {
+    if (!m_view || key == 0) return std::nullopt;
+    const size_t offset = bucketOffset(key);
+    std::lock_guard guard(m_mutex);
+    RangeLock lock(m_file, offset, m_settings.ways * sizeof(CacheSlot), false);
+    CacheSlot* slots = slotsAt(m_view, offset);
+    for (size_t way = 0; way < m_settings.ways; ++way) {
+        if (slots[way].key != key) continue;
+        const uint64_t tick = std::atomic_ref<uint64_t>(headerOf(m_view).clock).fetch_add(1, std::memory_order_relaxed) + 1;
+        std::atomic_ref<uint64_t>(slots[way].lastUsed).store(tick, std::memory_order_relaxed);
+        return slots[way].root;
+    }
+    return std::nullopt;
+}
+void PositionCache::store(uint64_t key, const CachedRoot& root) {
+    if (!m_view || key == 0) return;
+    const size_t offset = bucketOffset(key);
+    std::lock_guard guard(m_mutex);
+    RangeLock lock(m_file, offset, m_settings.ways * sizeof(CacheSlot), true);
+    CacheSlot* slots = slotsAt(m_view, offset);
+    CacheSlot* target = &slots[0];
+    for (size_t way = 0; way < m_settings.ways; ++way) {
+        if (slots[way].key == key) {
+            target = &slots[way];
+            break;
+        }
+        if (std::atomic_ref<uint64_t>(slots[way].lastUsed).load(std::memory_order_relaxed) <
+            std::atomic_ref<uint64_t>(target->lastUsed).load(std::memory_order_relaxed)) {
+            target = &slots[way];
+        }
+    }
+    target->key = key;
+    target->root = root;
+    const uint64_t tick = std::atomic_ref<uint64_t>(headerOf(m_view).clock).fetch_add(1, std::memory_order_relaxed) + 1;
+    std::atomic_ref<uint64_t>(target->lastUsed).store(tick, std::memory_order_relaxed);
+}
+size_t PositionCache::size() {
+    if (!m_view) return 0;
+    std::lock_guard guard(m_mutex);
+    size_t used = 0;
+    const CacheSlot* slots = slotsAt(m_view, sizeof(CacheHeader));
+    for (size_t i = 0; i < capacity(); ++i) {
+        if (slots[i].key != 0) ++used;
+    }
+    return used;
+}
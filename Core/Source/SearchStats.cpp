@@ -0,0 +1,45 @@
+module Core.SearchStats;
+import <algorithm>;
+import <array>;
+import <cstddef>;
+import <string>;
+using namespace Core;
+double SearchStats::averageTreeDepth() const {
+    const int recorded = std::max(iterations, 1);
+    return static_cast<double>(totalTreeDepth) / recorded;
+}
+void SearchStats::recordIteration(int treeDepth, int rolloutLength) {
+    ++iterations;
+    totalTreeDepth += treeDepth;
+    maxTreeDepth = std::max(maxTreeDepth, treeDepth);
+    const size_t bucket = std::min<size_t>(static_cast<size_t>(std::max(rolloutLength, 0) / RolloutBucketWidth), RolloutBuckets - 1);
+    ++rolloutLengths[bucket];
+}
+void SearchStats::merge(const SearchStats& other) {
+    iterations += other.iterations;
+    totalTreeDepth += other.totalTreeDepth;
+    maxTreeDepth = std::max(maxTreeDepth, other.maxTreeDepth);
+    for (size_t i = 0; i < RolloutBuckets; ++i) rolloutLengths[i] += other.rolloutLengths[i];
+    timedIterations += other.timedIterations;
+    selectMs += other.selectMs;
+    expandMs += other.expandMs;
+    simulateMs += other.simulateMs;
+    backpropagateMs += other.backpropagateMs;
+}
+void SearchStats::extrapolatePhaseTimes() {
+    if (timedIterations == 0) return;
+    const double scale = static_cast<double>(iterations) / timedIterations;
+    selectMs *= scale;
+    expandMs *= scale;
+    simulateMs *= scale;
+    backpropagateMs *= scale;
+    timedIterations = iterations;
+}
+std::string SearchStats::rolloutHistogram() const {
+    std::string histogram;
+    for (size_t i = 0; i < RolloutBuckets; ++i) {
+        if (i > 0) histogram += '|';
+        histogram += std::to_string(rolloutLengths[i]);
+    }
+    return histogram;
+}
@@ -0,0 +1,44 @@
+module Core.ThinkTimeManager;
+import <algorithm>;
+import <chrono>;
+import <cmath>;
+import <cstdlib>;
+import Core.MCTS;
+import Core.SearchStats;
+using namespace Core;
+ThinkTimeManager::ThinkTimeManager(ThinkTimeSettings settings)
+    : m_settings(settings)
+{
+    startGame();
+}
+void ThinkTimeManager::startGame() {
+    m_remaining = m_settings.gameBudget;
+    m_stability = 0.5;
+}
+bool ThinkTimeManager::isForced(const MCTSGameState& state) const {
+    return state.availableActions.size() <= 1;
+}
+bool ThinkTimeManager::isCritical(const MCTSGameState& state) const {
+    const int pawnDistance = 9 - std::abs(state.militaryPosition - 9);
+    const int science = std::max(state.player1.scientificSymbolCount(), state.player2.scientificSymbolCount());
+    return pawnDistance <= m_settings.criticalMilitaryDistance || science >= m_settings.criticalScienceSymbols;
+}
+std::chrono::milliseconds ThinkTimeManager::allocate(const MCTSGameState& state) const {
+    if (!isEnabled() || isForced(state)) return std::chrono::milliseconds{ 0 };
+    const int movesLeft = std::max((state.roundsRemaining + 1) / 2, 1);
+    const double remaining = static_cast<double>(m_remaining.count());
+    const double branching = std::clamp(std::sqrt(state.availableActions.size() / m_settings.typicalBranching), 0.5, 2.0);
+    const double age = state.currentPhase >= 3 ? 1.3 : state.currentPhase == 2 ? 1.0 : 0.8;
+    const double urgency = isCritical(state) ? 1.5 : 1.0;
+    const double instability = 1.5 - m_stability;
+    double budget = remaining / movesLeft * branching * age * urgency * instability;
+    budget = std::min(budget, remaining * m_settings.maximumShare);
+    const auto allocated = std::chrono::milliseconds{ static_cast<long long>(budget) };
+    return std::max(allocated, m_settings.minimumMove);
+}
+void ThinkTimeManager::record(std::chrono::milliseconds spent, const SearchStats& stats) {
+    m_remaining = std::max(m_remaining - spent, std::chrono::milliseconds{ 0 });
+    if (stats.iterations <= 0) return;
+    const double share = std::min(static_cast<double>(stats.bestNewVisits) / stats.iterations, 1.0);
+    m_stability = 0.5 * m_stability + 0.5 * share;
+}
@@ -9,6 +9,7 @@ import <chrono>;
 import <memory>;
 import Core.AIConfig;
 import Core.MCTS;
+import Core.SearchStats;
 namespace Core {
 TrainingLogger::TrainingLogger()
     : m_gameStarted(false)
@@ -43,7 +44,9 @@ void TrainingLogger::saveGameToCSV(const std::string& filename) {
     file << "Turn,CurrentPlayer,Phase,MilitaryPos,"
          << "P1_Coins,P1_Cards,P1_Wonders,P1_Blue,P1_Green,P1_Red,"
          << "P2_Coins,P2_Cards,P2_Wonders,P2_Blue,P2_Green,P2_Red,"
-         << "ActionType,CardName,CardIndex,StateValue,ExpectedReward\n";
+         << "ActionType,CardName,CardIndex,StateValue,ExpectedReward,"
+         << "Iterations,WallMs,IterationsPerSec,MaxTreeDepth,AvgTreeDepth,Nodes,Bytes,PeakBytes,Compactions,RolloutLengths,"
+         << "SelectMs,ExpandMs,SimulateMs,BackpropagateMs\n";
     for (const auto& turn : m_turns) {
         file << turn.turnNumber << ","
              << (turn.player1Turn ? "P1" : "P2") << ","
@@ -65,7 +68,21 @@ void TrainingLogger::saveGameToCSV(const std::string& filename) {
              << turn.cardName << ","
              << turn.cardNodeIndex << ","
              << turn.stateValue << ","
-             << turn.expectedReward << "\n";
+             << turn.expectedReward << ","
+             << turn.search.iterations << ","
+             << turn.search.wallMs << ","
+             << turn.search.iterationsPerSecond << ","
+             << turn.search.maxTreeDepth << ","
+             << turn.search.averageTreeDepth() << ","
+             << turn.search.nodesAllocated << ","
+             << turn.search.bytesUsed << ","
+             << turn.search.peakBytes << ","
+             << turn.search.compactions << ","
+             << turn.search.rolloutHistogram() << ","
+             << turn.search.selectMs << ","
+             << turn.search.expandMs << ","
+             << turn.search.simulateMs << ","
+             << turn.search.backpropagateMs << "\n";
     }
     file.close();
 }
@@ -109,7 +126,7 @@ void TrainingLogger::reset() {
     m_gameStarted = false;
 }
 TurnRecord createTurnRecord(const MCTSGameState& state, const MCTSAction& action, 
-                            int turnNum, double stateValue, double expectedReward) {
+                            int turnNum, const SearchStats& search) {
     TurnRecord record;
     record.turnNumber = turnNum;
     record.player1Turn = state.player1Turn;
@@ -133,10 +150,11 @@ TurnRecord createTurnRecord(const MCTSGameState& state, const MCTSAction& action
         case 2: record.actionType = "wonder"; break;
         default: record.actionType = "unknown"; break;
     }
-    record.cardName = action.cardName;
+    record.cardName = MCTSCardCatalog::get(action.cardId).name;
     record.cardNodeIndex = static_cast<int>(action.cardNodeIndex);
-    record.stateValue = stateValue;
-    record.expectedReward = expectedReward;
+    record.stateValue = search.rootValue;
+    record.expectedReward = search.bestValue;
+    record.search = search;
     return record;
 }
 } 
@@ -0,0 +1,62 @@
+module Core.TranspositionTable;
+import <atomic>;
+import <bit>;
+import <cstddef>;
+import <cstdint>;
+import <memory>;
+import <algorithm>;
+using namespace Core;
+TranspositionTable::TranspositionTable(size_t entries)
+    : m_bucketCount(std::bit_floor(std::max<size_t>(entries / BucketSize, 1)))
+{
+    m_entries = std::make_unique<Entry[]>(m_bucketCount * BucketSize);
+}
+void TranspositionTable::record(uint64_t key, double reward) {
+    Entry* bucket = bucketFor(key);
+    const uint32_t generation = m_generation.load(std::memory_order_relaxed);
+    Entry* victim = &bucket[0];
+    for (size_t i = 0; i < BucketSize; ++i) {
+        Entry& entry = bucket[i];
+        if (entry.key.load(std::memory_order_relaxed) == key) {
+            if (entry.generation.exchange(generation, std::memory_order_relaxed) != generation) {
+                entry.visits.store(1, std::memory_order_relaxed);
+                entry.totalValue.store(reward, std::memory_order_relaxed);
+                return;
+            }
+            entry.visits.fetch_add(1, std::memory_order_relaxed);
+            entry.totalValue.fetch_add(reward, std::memory_order_relaxed);
+            return;
+        }
+        const bool entryStale = entry.generation.load(std::memory_order_relaxed) != generation;
+        const bool victimStale = victim->generation.load(std::memory_order_relaxed) != generation;
+        if (entryStale != victimStale) {
+            if (entryStale) victim = &entry;
+        } else if (entry.visits.load(std::memory_order_relaxed) < victim->visits.load(std::memory_order_relaxed)) {
+            victim = &entry;
+        }
+    }
+    victim->key.store(key, std::memory_order_relaxed);
+    victim->visits.store(1, std::memory_order_relaxed);
+    victim->totalValue.store(reward, std::memory_order_relaxed);
+    victim->generation.store(generation, std::memory_order_relaxed);
+}
+bool TranspositionTable::probe(uint64_t key, TranspositionStats& stats) const {
+    const Entry* bucket = bucketFor(key);
+    const uint32_t generation = m_generation.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < BucketSize; ++i) {
+        if (bucket[i].key.load(std::memory_order_relaxed) != key) continue;
+        if (bucket[i].generation.load(std::memory_order_relaxed) != generation) return false;
+        stats.visits = bucket[i].visits.load(std::memory_order_relaxed);
+        stats.totalValue = bucket[i].totalValue.load(std::memory_order_relaxed);
+        return stats.visits > 0;
+    }
+    return false;
+}
+void TranspositionTable::clear() {
+    for (size_t i = 0; i < getCapacity(); ++i) {
+        m_entries[i].key.store(0, std::memory_order_relaxed);
+        m_entries[i].visits.store(0, std::memory_order_relaxed);
+        m_entries[i].generation.store(0, std::memory_order_relaxed);
+        m_entries[i].totalValue.store(0.0, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,213 @@
+module Core.WonderDraft;
+import <algorithm>;
+import <chrono>;
+import <filesystem>;
+import <fstream>;
+import <iomanip>;
+import <iostream>;
+import <mutex>;
+import <random>;
+import <sstream>;
+import <string>;
+import <thread>;
+import <unordered_map>;
+import <vector>;
+import Core.AIConfig;
+import Core.FileLock;
+import Core.MCTS;
+using namespace Core;
+namespace {
+    void assignWonder(MCTSGameState& state, bool player1, uint8_t wonderId) {
+        PlayerInfo& player = player1 ? state.player1 : state.player2;
+        if (player.wonderCount < PlayerInfo::MaxWonders) player.wonderIds[player.wonderCount++] = wonderId;
+    }
+    uint8_t takeRandom(std::vector<uint8_t>& table, std::mt19937& rng) {
+        std::uniform_int_distribution<size_t> dist(0, table.size() - 1);
+        const size_t index = dist(rng);
+        const uint8_t wonderId = table[index];
+        table[index] = table.back();
+        table.pop_back();
+        return wonderId;
+    }
+    double playDraftGame(const DraftPick& pick, size_t candidate, const UnseenCards& unseen, const AIWeights& weights,
+                         const PlayoutSettings& playout, int maxPlies, std::mt19937& rng) {
+        MCTSGameState state = pick.base;
+        std::vector<uint8_t> table = pick.offered;
+        table.erase(table.begin() + static_cast<std::ptrdiff_t>(candidate));
+        assignWonder(state, pick.picker(), pick.offered[candidate]);
+        for (size_t i = 1; i < pick.order.size() && !table.empty(); ++i) {
+            assignWonder(state, pick.order[i], takeRandom(table, rng));
+        }
+        std::vector<uint8_t> reserve = pick.reserve;
+        std::shuffle(reserve.begin(), reserve.end(), rng);
+        if (reserve.size() > pick.laterOrder.size()) reserve.resize(pick.laterOrder.size());
+        for (size_t i = 0; i < pick.laterOrder.size() && !reserve.empty(); ++i) {
+            assignWonder(state, pick.laterOrder[i], takeRandom(reserve, rng));
+        }
+        MCTS::determinize(state, unseen, rng);
+        state.player1Turn = std::bernoulli_distribution(0.5)(rng);
+        state.availableActions.clear();
+        state.features = MCTS::computeFeatures(state);
+        state.hash = MCTS::computeHash(state);
+        for (int ply = 0; ply < maxPlies && !MCTS::isTerminal(state); ++ply) {
+            if (state.availableActions.empty()) state.availableActions = MCTS::getLegalActions(state, state.currentPhase);
+            if (state.availableActions.empty()) break;
+            MCTS::applyAction(state, state.availableActions[playout.choose(state, rng)]);
+        }
+        double player1Value = 0.5;
+        if (MCTS::isTerminal(state)) {
+            const int winner = MCTS::getWinner(state);
+            player1Value = winner == 0 ? 1.0 : winner == 1 ? 0.0 : 0.5;
+        } else {
+            player1Value = MCTS::evaluateFeatures(state, weights);
+        }
+        return pick.picker() ? player1Value : 1.0 - player1Value;
+    }
+    int resolveThreadCount(int requested) {
+        if (requested > 0) return requested;
+        unsigned int hardware = std::thread::hardware_concurrency();
+        return hardware > 0 ? static_cast<int>(hardware) : 1;
+    }
+    std::mutex cacheFileMutex;
+}
+WonderDraftEvaluator::WonderDraftEvaluator(Playstyle playstyle, DraftSettings settings)
+    : m_playstyle(playstyle)
+    , m_settings(std::move(settings))
+    , m_rng(std::random_device{}())
+{
+    loadCache();
+}
+std::string WonderDraftEvaluator::cacheKey(const DraftPick& pick) {
+    auto names = [](std::vector<uint8_t> ids) {
+        std::vector<std::string> sorted;
+        for (uint8_t id : ids) sorted.push_back(MCTSCardCatalog::get(id).name);
+        std::sort(sorted.begin(), sorted.end());
+        std::string joined;
+        for (const auto& name : sorted) joined += name + ';';
+        return joined;
+    };
+    auto owned = [&](const PlayerInfo& player) {
+        return names(std::vector<uint8_t>(player.wonderIds.begin(), player.wonderIds.begin() + player.wonderCount));
+    };
+    auto order = [](const std::vector<bool>& picks) {
+        std::string encoded;
+        for (bool player1 : picks) encoded += player1 ? '1' : '2';
+        return encoded;
+    };
+    const bool picker = pick.picker();
+    return (picker ? "P1/" : "P2/") + owned(picker ? pick.base.player1 : pick.base.player2) + '/'
+         + owned(picker ? pick.base.player2 : pick.base.player1) + '/' + names(pick.offered) + '/'
+         + order(pick.order) + '/' + order(pick.laterOrder);
+}
+size_t WonderDraftEvaluator::choose(const DraftPick& pick) {
+    const std::vector<double> scores = evaluate(pick);
+    return static_cast<size_t>(std::distance(scores.begin(), std::max_element(scores.begin(), scores.end())));
+}
+std::vector<double> WonderDraftEvaluator::evaluate(const DraftPick& pick) {
+    const size_t candidates = pick.offered.size();
+    std::vector<double> scores(candidates, 0.5);
+    m_lastGames = 0;
+    m_lastCacheHit = false;
+    if (candidates < 2) return scores;
+    const std::string key = cacheKey(pick);
+    auto tallyFor = [&](size_t c) -> Tally& { return m_cache[key][MCTSCardCatalog::get(pick.offered[c]).name]; };
+    bool cached = true;
+    for (size_t c = 0; c < candidates; ++c) cached = cached && tallyFor(c).games >= m_settings.cachedGames;
+    if (cached) {
+        m_lastCacheHit = true;
+    } else {
+        const UnseenCards unseen = MCTS::captureUnseenCards();
+        const AIWeights weights = WeightsRegistry::current(m_playstyle).weights;
+        const PlayoutSettings playout;
+        const auto deadline = std::chrono::steady_clock::now() + m_settings.budget;
+        const int threadCount = resolveThreadCount(m_settings.threadCount);
+        std::vector<Tally> totals(candidates);
+        std::mutex totalsMutex;
+        {
+            std::vector<std::jthread> workers;
+            workers.reserve(static_cast<size_t>(threadCount));
+            for (int t = 0; t < threadCount; ++t) {
+                workers.emplace_back([&, seed = static_cast<uint32_t>(m_rng())]() {
+                    std::mt19937 rng(seed);
+                    std::vector<Tally> local(candidates);
+                    do {
+                        for (size_t c = 0; c < candidates; ++c) {
+                            for (int g = 0; g < m_settings.batchSize; ++g) {
+                                local[c].wins += playDraftGame(pick, c, unseen, weights, playout, m_settings.maxPlies, rng);
+                                ++local[c].games;
+                            }
+                        }
+                    } while (std::chrono::steady_clock::now() < deadline);
+                    std::lock_guard<std::mutex> lock(totalsMutex);
+                    for (size_t c = 0; c < candidates; ++c) {
+                        totals[c].wins += local[c].wins;
+                        totals[c].games += local[c].games;
+                    }
+                });
+            }
+        }
+        for (size_t c = 0; c < candidates; ++c) {
+            Tally& pending = m_pending[key][MCTSCardCatalog::get(pick.offered[c]).name];
+            pending.wins += totals[c].wins;
+            pending.games += totals[c].games;
+            tallyFor(c).wins += totals[c].wins;
+            tallyFor(c).games += totals[c].games;
+            m_lastGames += totals[c].games;
+        }
+        saveCache();
+    }
+    for (size_t c = 0; c < candidates; ++c) {
+        const Tally& tally = tallyFor(c);
+        if (tally.games > 0) scores[c] = tally.wins / tally.games;
+    }
+    std::cout << "[WonderDraft] " << (m_lastCacheHit ? "Cached scores" : "Simulated " + std::to_string(m_lastGames) + " games")
+              << " for " << candidates << " wonders\n";
+    return scores;
+}
+void WonderDraftEvaluator::loadCache() {
+    if (m_settings.cachePath.empty()) return;
+    std::ifstream file(m_settings.cachePath);
+    if (!file.is_open()) return;
+    std::string line;
+    std::getline(file, line);
+    while (std::getline(file, line)) {
+        std::stringstream ss(line);
+        std::string key, wonder, wins, games;
+        if (!std::getline(ss, key, ',') || !std::getline(ss, wonder, ',') ||
+            !std::getline(ss, wins, ',') || !std::getline(ss, games)) continue;
+        try {
+            Tally& tally = m_cache[key][wonder];
+            tally.wins = std::stod(wins);
+            tally.games = std::stoi(games);
+        } catch (...) {}
+    }
+}
+void WonderDraftEvaluator::saveCache() {
+    if (m_settings.cachePath.empty() || m_pending.empty()) return;
+    std::lock_guard<std::mutex> guard(cacheFileMutex);
+    FileLock lock(m_settings.cachePath + ".lock");
+    if (!lock.isLocked()) return;
+    m_cache.clear();
+    loadCache();
+    for (const auto& [key, entry] : m_pending) {
+        for (const auto& [wonder, tally] : entry) {
+            m_cache[key][wonder].wins += tally.wins;
+            m_cache[key][wonder].games += tally.games;
+        }
+    }
+    const std::string temporary = m_settings.cachePath + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::trunc);
+        if (!file.is_open()) return;
+        file << "Key,Wonder,Wins,Games\n" << std::setprecision(12);
+        for (const auto& [key, entry] : m_cache) {
+            for (const auto& [wonder, tally] : entry) {
+                file << key << ',' << wonder << ',' << tally.wins << ',' << tally.games << '\n';
+            }
+        }
+        if (!file.flush()) return;
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary, m_settings.cachePath, error);
+    if (!error) m_pending.clear();
+}
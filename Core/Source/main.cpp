@@ -13,8 +13,13 @@ import Core.TrainingLogger;
 import Core.PlayerDecisionMaker;
 import Core.GameMetadata;
 import Core.PlayerNameValidator;
+import Core.MCTSBenchmark;
 
-int main() {
+int main(int argc, char* argv[]) {
+	if (argc > 1 && std::string(argv[1]) == "--benchmark") {
+		Core::runMCTSBenchmarks();
+		return 0;
+	}
 	Core::Game::initGame();
 	return 0;
 }